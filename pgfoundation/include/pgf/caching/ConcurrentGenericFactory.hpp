@@ -0,0 +1,154 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <pgf/caching/GenericFactory.hpp>
+
+namespace pg::foundation {
+
+/**
+ * \brief A GenericFactory for concurrent registration and construction, optimized for reading.
+ *
+ * Registration copies the registered prototypes into a new frozen snapshot and publishes it atomically (RCU style).
+ * Readers announce themselves in one of two counters and load the current snapshot pointer, so looking up prototypes
+ * never waits on writers. A writer frees the replaced snapshot once all readers that could still see it are done,
+ * so only the current snapshot is kept. Each registration copies the whole registry: register many prototypes at once
+ * through update() where possible.
+ * Note that constructing through a pooled prototype still locks the prototype's ObjectPool.
+ */
+template <class T, typename... Arguments>
+class ConcurrentGenericFactory
+{
+public:
+    using Factory = GenericFactory<T, Arguments...>;
+    using Product = typename Factory::Product;
+
+    /**
+     * Access to the snapshot current at creation. Registrations wait for all Snapshots that may refer to a replaced
+     * snapshot, so keep them short-lived and never register while holding one.
+     */
+    class Snapshot
+    {
+    public:
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        ~Snapshot() { _readers->fetch_sub(1, std::memory_order_release); }
+
+        const Factory& operator*() const { return *_factory; }
+
+        const Factory* operator->() const { return _factory; }
+
+    private:
+        friend class ConcurrentGenericFactory;
+
+        explicit Snapshot(const ConcurrentGenericFactory& owner)
+          : _readers(&owner._readers[owner._epoch.load(std::memory_order_seq_cst) & 1].count)
+        {
+            // announce the reader before loading the pointer, see synchronize()
+            _readers->fetch_add(1, std::memory_order_seq_cst);
+            _factory = owner._current.load(std::memory_order_seq_cst);
+        }
+
+        std::atomic<size_t>* _readers;
+        const Factory*       _factory = nullptr;
+    };
+
+    ConcurrentGenericFactory() { publish(); }
+
+    ConcurrentGenericFactory(const ConcurrentGenericFactory&) = delete;
+    ConcurrentGenericFactory& operator=(const ConcurrentGenericFactory&) = delete;
+
+    // register a prototype, see GenericFactory::registerPrototype
+    template <typename Prototype>
+    bool registerPrototype(std::string_view key, Prototype&& prototype)
+    {
+        std::lock_guard lk(_mutex);
+        if (!_staging.registerPrototype(key, std::forward<Prototype>(prototype))) { return false; }
+        publish();
+        return true;
+    }
+
+    /**
+     * \brief apply several registrations and publish them as a single snapshot
+     * \example:
+     * factory.update([](auto& f) {
+     *     f.registerPrototype("kitty", GenericFactory<Kitty>::proto());
+     *     f.registerPrototype("doggy", GenericFactory<Doggy>::proto());
+     * });
+     */
+    template <typename Update>
+    void update(Update&& update_function)
+    {
+        std::lock_guard lk(_mutex);
+        update_function(_staging);
+        publish();
+    }
+
+    bool hasPrototypeName(std::string_view key) const { return snapshot()->hasPrototypeName(key); }
+
+    auto make(std::string_view key, Arguments&&... args) const
+    {
+        return snapshot()->make(key, std::forward<Arguments>(args)...);
+    }
+
+    template <typename... Args>
+    std::vector<Product> makeN(std::string_view key, size_t count, Args&&... args) const
+    {
+        return snapshot()->makeN(key, count, std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief the current frozen snapshot, hot paths can resolve key ids once and use them with make(KeyId) on the same
+     * snapshot
+     */
+    Snapshot snapshot() const { return Snapshot(*this); }
+
+private:
+    // requires _mutex to be held (or the constructor running)
+    void publish()
+    {
+        auto next = std::make_unique<Factory>(_staging);
+        next->freeze();
+        _current.store(next.get(), std::memory_order_seq_cst);
+        std::swap(_published, next);
+        if (next)
+        {
+            synchronize();
+            next.reset();
+        }
+    }
+
+    /**
+     * Wait until no reader can use a snapshot replaced before the call. A reader that loaded the old pointer announced
+     * itself before the new pointer was stored, so it is counted in one of the counters until it is done. New readers
+     * go to the other counter, which keeps a steady stream of readers from starving the writer.
+     */
+    void synchronize()
+    {
+        for (int phase = 0; phase < 2; ++phase)
+        {
+            const auto previous = _epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+            while (_readers[previous].count.load(std::memory_order_seq_cst) != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    struct alignas(64) ReaderCount
+    {
+        std::atomic<size_t> count{0};
+    };
+
+    std::mutex                  _mutex;
+    Factory                     _staging;   //< mutable registry, only touched by writers
+    std::unique_ptr<Factory>    _published; //< owns the current snapshot
+    std::atomic<const Factory*> _current{nullptr};
+    std::atomic<size_t>         _epoch{0};  //< its lowest bit selects the counter of new readers
+    mutable ReaderCount         _readers[2];
+};
+} // namespace pg::foundation
@@ -1,20 +1,169 @@
 #pragma once
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <format>
 #include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <ranges>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <pgf/memory/ObjectPool.hpp>
 
 namespace pg::foundation {
 
+/**
+ * Deleter of objects made by a GenericFactory. Objects from plain prototypes are deleted, objects from pooled
+ * prototypes are destroyed and their storage is handed back to the pool.
+ * As with std::default_delete, deleting through a base requires a virtual destructor.
+ */
+struct FactoryDeleter
+{
+    using Release = void (*)(void* pool, void* storage);
+
+    FactoryDeleter() = default;
+
+    FactoryDeleter(Release release_function, void* owning_pool)
+      : release(release_function)
+      , pool(owning_pool)
+    {
+    }
+
+    // allows products of plain prototypes made by std::make_unique
+    template <typename U>
+    FactoryDeleter(std::default_delete<U> /*unused*/) noexcept
+    {
+    }
+
+    template <typename U>
+    void operator()(U* object) const
+    {
+        if (release == nullptr)
+        {
+            delete object;
+            return;
+        }
+        // the pool storage starts at the most derived object
+        void* storage = nullptr;
+        if constexpr (std::is_polymorphic_v<U>) { storage = dynamic_cast<void*>(object); }
+        else { storage = object; }
+        std::destroy_at(object);
+        release(pool, storage);
+    }
+
+    Release release = nullptr;
+    void*   pool = nullptr;
+};
+
 template <class T, typename... Arguments>
 class GenericFactory
 {
 public:
-    using CtorFunc = std::function<typename std::unique_ptr<typename std::remove_pointer_t<T>>(Arguments&&...)>;
+    using Product = std::unique_ptr<std::remove_pointer_t<T>, FactoryDeleter>;
+    using CtorFunc = std::function<Product(Arguments&&...)>;
+
+    // how bulk construction takes an argument: references are passed on, values are copied for each object
+    template <typename Argument>
+    using BulkArgument =
+        std::conditional_t<std::is_lvalue_reference_v<Argument>, Argument, const std::remove_reference_t<Argument>&>;
+    // constructs count objects into the vector, the arguments are passed to each of them
+    using BulkCtorFunc = std::function<void(size_t, std::vector<Product>&, BulkArgument<Arguments>...)>;
+
+    // makeN needs a copy of each argument per object
+    static constexpr bool is_bulk_constructible =
+        ((std::is_lvalue_reference_v<Arguments> || std::is_copy_constructible_v<std::remove_cvref_t<Arguments>>) &&
+         ...);
+
+    /**
+     * Prototype allocating its objects from an ObjectPool shared by all copies of the prototype.
+     * Besides single objects it can construct objects in adjacent storage, see GenericFactory::makeN
+     */
+    template <size_t ChunkSize, typename... FixedParameters>
+    class PooledPrototype
+    {
+        using Pool = ObjectPool<T, ChunkSize>;
+
+    public:
+        static constexpr bool is_pooled_prototype = true;
+
+        explicit PooledPrototype(FixedParameters... fixed)
+          : _pool(Pool::create())
+          , _fixed(std::move(fixed)...)
+        {
+        }
+
+        PooledPrototype(const PooledPrototype& other)
+          : _pool(other._pool)
+          , _fixed(other._fixed)
+        {
+            _pool->retain();
+        }
+
+        PooledPrototype& operator=(const PooledPrototype&) = delete;
+
+        ~PooledPrototype() { _pool->release(); }
+
+        std::unique_ptr<T, FactoryDeleter> operator()(Arguments&&... args) const
+        {
+            void* storage = _pool->allocate();
+            try
+            {
+                return {construct(storage, std::forward<Arguments>(args)...), deleter()};
+            }
+            catch (...)
+            {
+                _pool->deallocate(storage);
+                throw;
+            }
+        }
+
+        // construct count objects in adjacent slots, out is called with (T*, FactoryDeleter) for each
+        template <typename Out>
+        void makeN(size_t count, Out&& out, BulkArgument<Arguments>... args) const
+        {
+            if (count == 0) { return; }
+            auto*  storage = _pool->allocateContiguous(count);
+            size_t i = 0;
+            try
+            {
+                for (; i < count; ++i)
+                {
+                    out(construct(storage + i * Pool::stride(), copyArgument<Arguments>(args)...), deleter());
+                }
+            }
+            catch (...)
+            {
+                for (; i < count; ++i)
+                {
+                    _pool->deallocate(storage + i * Pool::stride());
+                }
+                throw;
+            }
+        }
+
+    private:
+        template <typename... Args>
+        T* construct(void* storage, Args&&... args) const
+        {
+            return std::apply(
+                [&](const auto&... fixed) { return ::new (storage) T(std::forward<Args>(args)..., fixed...); },
+                _fixed);
+        }
+
+        FactoryDeleter deleter() const
+        {
+            return {[](void* pool, void* storage) { static_cast<Pool*>(pool)->deallocate(storage); }, _pool};
+        }
+
+        Pool*                          _pool;
+        std::tuple<FixedParameters...> _fixed;
+    };
 
     // only value semantics for fixed parameters for now
     template <typename... FixedParameters>
@@ -29,18 +178,73 @@ public:
         return [](Arguments&&... args) { return std::make_unique<T>(std::forward<Arguments>(args)...); };
     }
 
+    /**
+     * \brief prototype constructing into a per-type object pool instead of allocating each object on its own
+     * \example:
+     * f.registerPrototype("particle", GenericFactory<Particle, int>::pooledProto<256>());
+     */
+    template <size_t ChunkSize = 64, typename... FixedParameters>
+    static auto pooledProto(FixedParameters... fixed)
+    {
+        return PooledPrototype<ChunkSize, FixedParameters...>(std::move(fixed)...);
+    }
+
+    // dense id of a key in a frozen factory, see freeze()
+    using KeyId = uint32_t;
+
     GenericFactory() = default;
     ~GenericFactory() = default;
 
+    GenericFactory(const GenericFactory& other)
+      : registeredConstructors(other.registeredConstructors)
+    {
+        // the frozen table refers into the own map
+        if (other.isFrozen()) { freeze(); }
+    }
+
+    GenericFactory& operator=(const GenericFactory& other)
+    {
+        if (this != &other) { *this = GenericFactory(other); }
+        return *this;
+    }
+
+    GenericFactory(GenericFactory&&) noexcept = default;
+    GenericFactory& operator=(GenericFactory&&) noexcept = default;
+
     /**
      * \brief register a prototype
+     * \throws std::logic_error if the factory is frozen
      * \example:
      * GenericFactory<X> f;
      * f.registerPrototype("kitty", GenericFactory<X>::proto());
      */
     bool registerPrototype(std::string_view key, CtorFunc&& constructor_function)
     {
-        auto ret = registeredConstructors.emplace(key, std::move(constructor_function));
+        if (isFrozen()) { throw std::logic_error(std::format("Cannot register {} in a frozen factory", key)); }
+        auto ret = registeredConstructors.emplace(key, Prototype{std::move(constructor_function), {}});
+        return ret.second;
+    }
+
+    /**
+     * \brief register a pooled prototype, which also supports bulk construction through makeN
+     * \example:
+     * f.registerPrototype("kitty", GenericFactory<Kitty>::pooledProto());
+     */
+    template <typename Pooled>
+        requires std::remove_cvref_t<Pooled>::is_pooled_prototype
+    bool registerPrototype(std::string_view key, Pooled&& pooled)
+    {
+        if (isFrozen()) { throw std::logic_error(std::format("Cannot register {} in a frozen factory", key)); }
+        // without copyable arguments the prototype still makes single objects
+        BulkCtorFunc bulk;
+        if constexpr (is_bulk_constructible)
+        {
+            bulk = [pooled](size_t count, std::vector<Product>& out, BulkArgument<Arguments>... args) {
+                pooled.makeN(
+                    count, [&out](auto* object, FactoryDeleter deleter) { out.emplace_back(object, deleter); }, args...);
+            };
+        }
+        auto ret = registeredConstructors.emplace(key, Prototype{std::forward<Pooled>(pooled), std::move(bulk)});
         return ret.second;
     }
 
@@ -51,20 +255,93 @@ public:
      */
     const CtorFunc& getPrototype(std::string_view type_name) const
     {
-        return registeredConstructors.at(std::string(type_name));
+        return findPrototype(type_name).constructor;
     }
 
     /**
      * \brief Check if any prototype with a given name is registered
      * \param key
      */
-    bool hasPrototypeName(std::string_view key) const { return registeredConstructors.contains(key); }
+    bool hasPrototypeName(std::string_view key) const
+    {
+        if (isFrozen()) { return findFrozen(key) != frozenConstructors.end(); }
+        return registeredConstructors.contains(key);
+    }
 
     /**
      * \brief construct an instance of the registered type
      * \param key
      */
-    auto make(std::string_view key, Arguments&&... args) { return getPrototype(key)(std::forward<Arguments>(args)...); }
+    auto make(std::string_view key, Arguments&&... args) const
+    {
+        return getPrototype(key)(std::forward<Arguments>(args)...);
+    }
+
+    /**
+     * \brief construct an instance by the id of a frozen key, without any lookup
+     * \param id result of keyId(), only valid for a frozen factory
+     */
+    auto make(KeyId id, Arguments&&... args) const
+    {
+        assert(id < frozenConstructors.size());
+        return frozenConstructors[id].prototype->constructor(std::forward<Arguments>(args)...);
+    }
+
+    /**
+     * \brief construct count instances, each with a copy of the arguments.
+     * The arguments are converted to the factory's argument types once. Pooled prototypes construct the objects in
+     * adjacent storage, others construct them one by one.
+     */
+    template <typename... Args>
+        requires is_bulk_constructible
+    std::vector<Product> makeN(std::string_view key, size_t count, Args&&... args) const
+    {
+        return constructN(findPrototype(key), count, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+        requires is_bulk_constructible
+    std::vector<Product> makeN(KeyId id, size_t count, Args&&... args) const
+    {
+        assert(id < frozenConstructors.size());
+        return constructN(*frozenConstructors[id].prototype, count, std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief compile the registered prototypes into a flat table sorted by key hash.
+     * Lookups by name then take a hash and a binary search without allocating, and keys can be resolved to dense ids
+     * for make(KeyId). No prototypes can be registered afterwards.
+     */
+    void freeze()
+    {
+        frozenConstructors.clear();
+        frozenConstructors.reserve(registeredConstructors.size());
+        for (const auto& [key, prototype] : registeredConstructors)
+        {
+            frozenConstructors.push_back({hashKey(key), key, &prototype});
+        }
+        std::ranges::sort(frozenConstructors, [](const auto& lhs, const auto& rhs) {
+            return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhs.key < rhs.key;
+        });
+        frozen = true;
+    }
+
+    bool isFrozen() const { return frozen; }
+
+    /**
+     * \brief resolve a key to the id used by make(KeyId). Ids are stable for the lifetime of the frozen factory.
+     * \throws std::logic_error if the factory is not frozen, std::out_of_range if the key is not registered
+     */
+    KeyId keyId(std::string_view key) const
+    {
+        if (!isFrozen()) { throw std::logic_error("Key ids are only available for frozen factories"); }
+        auto it = findFrozen(key);
+        if (it == frozenConstructors.end())
+        {
+            throw std::out_of_range(std::format("No prototype registered for {}", key));
+        }
+        return static_cast<KeyId>(std::distance(frozenConstructors.begin(), it));
+    }
 
     /**
      * \brief Get all keys
@@ -72,7 +349,74 @@ public:
     auto getKeys() const { return std::views::keys(registeredConstructors); }
 
 private:
-    std::map<std::string, CtorFunc, std::less<>> registeredConstructors; ///< Mapping of key to constructors
+    struct Prototype
+    {
+        CtorFunc     constructor;
+        BulkCtorFunc bulk_constructor; //< only set for pooled prototypes
+    };
+
+    struct FrozenEntry
+    {
+        size_t           hash;
+        std::string_view key;       //< refers to the key in registeredConstructors
+        const Prototype* prototype; //< refers to the value in registeredConstructors
+    };
+
+    const Prototype& findPrototype(std::string_view key) const
+    {
+        if (isFrozen()) { return *frozenConstructors[keyId(key)].prototype; }
+        auto it = registeredConstructors.find(key);
+        if (it == registeredConstructors.end())
+        {
+            throw std::out_of_range(std::format("No prototype registered for {}", key));
+        }
+        return it->second;
+    }
+
+    // an argument of makeN converted to the factory's argument type, values are held by value
+    template <typename Argument>
+    using StoredArgument =
+        std::conditional_t<std::is_lvalue_reference_v<Argument>, Argument, std::remove_cvref_t<Argument>>;
+
+    static std::vector<Product> constructN(const Prototype& prototype, size_t count, StoredArgument<Arguments>... args)
+    {
+        std::vector<Product> result;
+        result.reserve(count);
+        if (prototype.bulk_constructor) { prototype.bulk_constructor(count, result, args...); }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                result.emplace_back(prototype.constructor(copyArgument<Arguments>(args)...));
+            }
+        }
+        return result;
+    }
+
+    // a fresh copy of a bulk argument for one object, references are passed on
+    template <typename Argument>
+    static decltype(auto) copyArgument(BulkArgument<Argument> argument)
+    {
+        if constexpr (std::is_lvalue_reference_v<Argument>) { return argument; }
+        else { return std::remove_cvref_t<Argument>(argument); }
+    }
+
+    static size_t hashKey(std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+    auto findFrozen(std::string_view key) const
+    {
+        const auto hash = hashKey(key);
+        auto       it = std::ranges::lower_bound(frozenConstructors, hash, {}, &FrozenEntry::hash);
+        for (; it != frozenConstructors.end() && it->hash == hash; ++it)
+        {
+            if (it->key == key) { return it; }
+        }
+        return frozenConstructors.end();
+    }
+
+    std::map<std::string, Prototype, std::less<>> registeredConstructors; ///< Mapping of key to constructors
+    std::vector<FrozenEntry>                      frozenConstructors;     ///< sorted by hash, only set when frozen
+    bool                                          frozen = false;
 };
 } // namespace pg::foundation
 
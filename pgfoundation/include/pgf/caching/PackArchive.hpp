@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <pgf/filesystem/MappedFile.hpp>
+
+namespace pg::foundation {
+
+/**
+ * A simple packed resource archive. All resources are stored in a single file so they can be served from one mapping.
+ * Layout (native little endian):
+ *  [Header][IndexEntry * entry_count][names][padding][aligned blobs...]
+ * The index is sorted by (hash, name), so lookups are a binary search on the hash straight on the mapped memory.
+ */
+namespace pack {
+struct Header
+{
+    std::array<char, 8> magic;
+    uint32_t            version;
+    uint32_t            entry_count;
+    uint64_t            names_offset; //< start of the name blob
+    uint64_t            names_size;
+    uint64_t            alignment; //< alignment of the data blobs
+};
+
+struct IndexEntry
+{
+    uint64_t hash;
+    uint64_t offset; //< absolute offset of the blob in the archive
+    uint64_t size;
+    uint32_t name_offset; //< relative to Header::names_offset
+    uint32_t name_length;
+};
+
+inline constexpr std::array<char, 8> magic{'P', 'G', 'F', 'P', 'A', 'C', 'K', '\0'};
+inline constexpr uint32_t            version = 1;
+
+// FNV-1a, stable across platforms and runs as it is persisted
+constexpr uint64_t hashUri(std::string_view uri)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (auto c : uri)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+} // namespace pack
+
+/**
+ * Read access to a packed archive. The archive is mapped once, resources are returned as slices of that mapping.
+ */
+class PackArchive
+{
+public:
+    explicit PackArchive(const std::filesystem::path& archive);
+
+    bool contains(std::string_view uri) const { return find(uri) != nullptr; }
+
+    /**
+     * \brief get the bytes of a packed resource.
+     * \throws std::out_of_range if the archive does not contain the uri
+     */
+    MappedFile open(std::string_view uri) const;
+
+    // number of packed resources
+    size_t size() const { return _index.size(); }
+
+    // all packed uris, in index order
+    std::vector<std::string_view> uris() const;
+
+    const std::filesystem::path& path() const { return _path; }
+
+private:
+    const pack::IndexEntry* find(std::string_view uri) const;
+
+    std::string_view name(const pack::IndexEntry& entry) const;
+
+    std::filesystem::path             _path;
+    MappedFile                        _file;
+    std::span<const pack::IndexEntry> _index;
+    std::string_view                  _names;
+};
+
+/**
+ * Collects resources and writes them into a packed archive.
+ */
+class PackWriter
+{
+public:
+    // add a file, uri is the key used for lookups
+    void add(std::string uri, std::filesystem::path source);
+
+    // add all regular files below a directory, uris are the generic relative paths
+    void addDirectory(const std::filesystem::path& root);
+
+    /**
+     * \brief write the archive.
+     * \param alignment alignment of each blob, must be a power of two. Use the page size to allow mapping single blobs
+     */
+    void write(const std::filesystem::path& archive, size_t alignment = 16) const;
+
+private:
+    std::vector<std::pair<std::string, std::filesystem::path>> _entries;
+};
+
+} // namespace pg::foundation
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <filesystem>
+#include <format>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+namespace pg::foundation {
+
+/**
+ * A set of resources to be warmed up together, e.g. everything needed by a level.
+ * Resource types are only known at compile time, so uris are grouped by a name chosen by the application which maps
+ * each group to a ResourceManager::prefetch<T> call. YAML or JSON:
+ *
+ * concurrency: 8          # optional, 0 or missing uses the hardware concurrency
+ * groups:
+ *   sounds: [bang.wav, boom.wav]
+ *   levels: [level1.json]
+ */
+struct PrefetchManifest
+{
+    size_t                                                       concurrency = 0;
+    std::map<std::string, std::vector<std::string>, std::less<>> groups;
+
+    static PrefetchManifest fromYaml(const YAML::Node& root)
+    {
+        PrefetchManifest manifest;
+        if (!root.IsMap()) { throw std::invalid_argument("Prefetch manifest must be a map"); }
+        if (auto concurrency = root["concurrency"]) { manifest.concurrency = concurrency.as<size_t>(); }
+        for (auto&& group : root["groups"])
+        {
+            manifest.groups.emplace(group.first.as<std::string>(), group.second.as<std::vector<std::string>>());
+        }
+        return manifest;
+    }
+
+    static PrefetchManifest fromFile(const std::filesystem::path& path)
+    {
+        try
+        {
+            return fromYaml(YAML::LoadFile(path.string()));
+        }
+        catch (const YAML::Exception& e)
+        {
+            throw std::invalid_argument(std::format("Invalid prefetch manifest {}: {}", path.string(), e.what()));
+        }
+    }
+
+    // uris of a group, empty if the group is not listed
+    const std::vector<std::string>& group(std::string_view name) const
+    {
+        static const std::vector<std::string> empty;
+        auto                                  it = groups.find(name);
+        return it != groups.end() ? it->second : empty;
+    }
+
+    // total number of uris over all groups
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const auto& [_, uris] : groups)
+        {
+            total += uris.size();
+        }
+        return total;
+    }
+};
+} // namespace pg::foundation
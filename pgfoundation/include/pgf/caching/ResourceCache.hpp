@@ -1,8 +1,10 @@
 #pragma once
 #include <any>
-#include <sdlpp.hpp>
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <pgf/caching/ResourceStatistics.hpp>
 
 namespace pg::foundation {
 using URI = std::string;
@@ -23,32 +25,124 @@ public:
     template <typename Resource>
     std::shared_ptr<Resource> get(const URI& uri)
     {
-        return std::any_cast<std::shared_ptr<Resource>>(_resources.at(uri));
+        auto& entry = _resources.at(uri);
+        if (entry.statistics != nullptr) { entry.statistics->recordHit(); }
+        return std::any_cast<std::shared_ptr<Resource>>(entry.resource);
     }
 
     template <typename Resource>
     std::shared_ptr<Resource> retrieve(const URI& uri)
     {
-        if (!has(uri)) { _resources[uri] = std::make_shared<Resource>(uri); }
-        return std::any_cast<std::shared_ptr<Resource>>(_resources[uri]);
+        return lookupOrMake<Resource>(uri, [&uri] { return std::make_shared<Resource>(uri); });
+    }
+
+    /**
+     * \brief add an already created resource. An existing entry for the uri is kept and returned instead.
+     */
+    template <typename Resource>
+    std::shared_ptr<Resource> insert(const URI& uri, std::shared_ptr<Resource> resource)
+    {
+        auto [it, inserted] = _resources.try_emplace(uri);
+        if (inserted) { it->second = makeEntry(std::move(resource)); }
+        return std::any_cast<std::shared_ptr<Resource>>(it->second.resource);
+    }
+
+    // replace or add a resource, holders of the previous version keep it alive until they let go
+    template <typename Resource>
+    void replace(const URI& uri, std::shared_ptr<Resource> resource)
+    {
+        auto& entry = _resources[uri];
+        if (entry.statistics != nullptr) { entry.statistics->recordRelease(entry.footprint); }
+        entry = makeEntry(std::move(resource));
     }
 
     template <typename Resource, typename Maker, typename... Args>
     std::shared_ptr<Resource> retrieve(const URI& uri, Maker&& maker, Args... args)
     {
-        if (!has(uri)) { _resources[uri] = std::make_shared<Resource>(std::move(maker(uri, args...))); }
-        return std::any_cast<std::shared_ptr<Resource>>(_resources[uri]);
+        return lookupOrMake<Resource>(uri, [&] { return std::make_shared<Resource>(std::move(maker(uri, args...))); });
     }
 
     template <typename Resource, typename Maker>
     std::shared_ptr<Resource> retrieve(const URI& uri, Maker&& maker)
     {
-        if (!has(uri)) { _resources[uri] = std::make_shared<Resource>(std::move(maker(uri))); }
-        return std::any_cast<std::shared_ptr<Resource>>(_resources[uri]);
+        return lookupOrMake<Resource>(uri, [&] { return std::make_shared<Resource>(std::move(maker(uri))); });
+    }
+
+    // remove a resource from the cache, holders of the resource keep it alive until they let go
+    bool evict(const URI& uri)
+    {
+        auto it = _resources.find(uri);
+        if (it == _resources.end()) { return false; }
+        if (it->second.statistics != nullptr) { it->second.statistics->recordEviction(it->second.footprint); }
+        _resources.erase(it);
+        return true;
+    }
+
+    void clear()
+    {
+        for (const auto& [_, entry] : _resources)
+        {
+            if (entry.statistics != nullptr) { entry.statistics->recordEviction(entry.footprint); }
+        }
+        _resources.clear();
+    }
+
+    // start collecting statistics, resources cached before are not accounted for
+    void enableStatistics()
+    {
+        if (!_statistics) { _statistics = std::make_unique<CacheStatistics>(); }
+    }
+
+    // nullptr if statistics are not enabled
+    CacheStatistics* statistics() const { return _statistics.get(); }
+
+    template <typename Resource>
+    ResourceStatistics* statisticsFor() const
+    {
+        return _statistics ? &_statistics->forType<Resource>() : nullptr;
     }
 
 private:
-    std::unordered_map<URI, std::any> _resources;
+    struct Entry
+    {
+        std::any            resource;
+        size_t              footprint = 0;
+        ResourceStatistics* statistics = nullptr;
+    };
+
+    template <typename Resource>
+    Entry makeEntry(std::shared_ptr<Resource>&& resource)
+    {
+        Entry entry{{}, 0, statisticsFor<Resource>()};
+        if (entry.statistics != nullptr && resource)
+        {
+            entry.footprint = resourceFootprint(*resource);
+            entry.statistics->recordResident(entry.footprint);
+        }
+        entry.resource = std::move(resource);
+        return entry;
+    }
+
+    template <typename Resource, typename Make>
+    std::shared_ptr<Resource> lookupOrMake(const URI& uri, Make&& make)
+    {
+        auto* statistics = statisticsFor<Resource>();
+        if (auto it = _resources.find(uri); it != _resources.end())
+        {
+            if (statistics != nullptr) { statistics->recordHit(); }
+            return std::any_cast<std::shared_ptr<Resource>>(it->second.resource);
+        }
+        if (statistics == nullptr) { return insert(uri, make()); }
+
+        statistics->recordMiss();
+        const auto start = ResourceStatistics::Clock::now();
+        auto       resource = make();
+        statistics->recordLoad(ResourceStatistics::Clock::now() - start);
+        return insert(uri, std::move(resource));
+    }
+
+    std::unordered_map<URI, Entry>   _resources;
+    std::unique_ptr<CacheStatistics> _statistics;
 };
 
 /**
@@ -68,16 +162,51 @@ public:
 
     std::shared_ptr<Resource> load(const URI& uri)
     {
-        if (!_resources.contains(uri))
+        if (auto it = _resources.find(uri); it != _resources.end())
+        {
+            if (_statistics) { _statistics->recordHit(); }
+            return it->second;
+        }
+        if (!_statistics)
         {
             // TODO: use std::filesystem
-            _resources[uri] = std::make_shared<Resource>(std::move(_maker(uri)));
+            return _resources[uri] = std::make_shared<Resource>(std::move(_maker(uri)));
+        }
+
+        _statistics->recordMiss();
+        const auto start = ResourceStatistics::Clock::now();
+        auto       resource = std::make_shared<Resource>(std::move(_maker(uri)));
+        _statistics->recordLoad(ResourceStatistics::Clock::now() - start);
+        _statistics->recordResident(resourceFootprint(*resource));
+        return _resources[uri] = std::move(resource);
+    }
+
+    bool evict(const URI& uri)
+    {
+        auto it = _resources.find(uri);
+        if (it == _resources.end()) { return false; }
+        if (_statistics) { _statistics->recordEviction(resourceFootprint(*it->second)); }
+        _resources.erase(it);
+        return true;
+    }
+
+    // start collecting statistics
+    void enableStatistics()
+    {
+        if (_statistics) { return; }
+        _statistics = std::make_unique<ResourceStatistics>();
+        for (const auto& [_, resource] : _resources)
+        {
+            _statistics->recordResident(resourceFootprint(*resource));
         }
-        return _resources[uri];
     }
 
+    // nullptr if statistics are not enabled
+    const ResourceStatistics* statistics() const { return _statistics.get(); }
+
 private:
     std::unordered_map<URI, std::shared_ptr<Resource>> _resources{};
     Maker                                              _maker;
+    std::unique_ptr<ResourceStatistics>                _statistics;
 };
 } // namespace pg::foundation
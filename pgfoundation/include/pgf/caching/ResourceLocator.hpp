@@ -1,5 +1,9 @@
 #pragma once
 #include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <pgf/caching/PackArchive.hpp>
 
 namespace pg::foundation {
 
@@ -9,6 +13,9 @@ public:
     std::filesystem::path locate(this auto&& self, const std::string& uri) { return self.loc_impl(uri); }
 
     bool contains(this auto&& self, const std::string& uri) { return self.has_impl(uri); }
+
+    // direct access to the bytes of a resource, only for locators that serve resources from memory
+    MappedFile open(this auto&& self, const std::string& uri) { return self.open_impl(uri); }
 };
 
 class IdentityResourceLocator : public ResourceLocatorBase
@@ -52,8 +59,66 @@ public:
 
     std::filesystem::path loc_impl(const std::string& uri) { return _basePath / std::filesystem::path{uri}; }
 
+    bool has_impl(const std::string& uri) { return std::filesystem::exists(loc_impl(uri)); }
+
 private:
     std::filesystem::path _basePath;
 };
 
+/**
+ * Resource locator resolving uris against an ordered list of roots, earlier roots shadow later ones.
+ * The roots are scanned once (in parallel) into an index, so locate/contains never touch the file system.
+ * Uris are the generic paths relative to the roots.
+ */
+class IndexedResourceLocator : public ResourceLocatorBase
+{
+public:
+    IndexedResourceLocator(std::vector<std::filesystem::path> roots);
+
+    // \throws std::out_of_range if the uri is not indexed
+    std::filesystem::path loc_impl(const std::string& uri) const;
+
+    bool has_impl(const std::string& uri) const { return _index.contains(uri); }
+
+    /**
+     * \brief rescan a directory relative to the roots, e.g. after files were added or removed.
+     * An empty path rescans everything.
+     */
+    void refresh(const std::filesystem::path& relative_directory = {});
+
+    // re-resolve a single uri against the roots
+    void refreshUri(const std::string& uri);
+
+    // number of indexed uris
+    size_t size() const { return _index.size(); }
+
+    const std::vector<std::filesystem::path>& getRoots() const { return _roots; }
+
+private:
+    std::vector<std::filesystem::path>                     _roots;
+    std::unordered_map<std::string, std::filesystem::path> _index;
+};
+
+// resource locator that serves resources from a single memory mapped pack archive
+class PackResourceLocator : public ResourceLocatorBase
+{
+public:
+    PackResourceLocator(const std::filesystem::path& archive)
+      : _archive(archive)
+    {
+    }
+
+    // resources have no file of their own, the path is only informative. Use open() to access the bytes
+    std::filesystem::path loc_impl(const std::string& uri) { return _archive.path() / std::filesystem::path{uri}; }
+
+    bool has_impl(const std::string& uri) { return _archive.contains(uri); }
+
+    MappedFile open_impl(const std::string& uri) { return _archive.open(uri); }
+
+    const PackArchive& getArchive() const { return _archive; }
+
+private:
+    PackArchive _archive;
+};
+
 } // namespace pg::foundation
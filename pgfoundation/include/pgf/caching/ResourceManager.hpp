@@ -1,9 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <ranges>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <pgf/caching/ResourceCache.hpp>
 #include <pgf/caching/ResourceLocator.hpp>
+#include <pgf/caching/ResourceWatcher.hpp>
+#include <pgf/filesystem/MappedFile.hpp>
 
 namespace pg::foundation {
 
@@ -19,6 +31,38 @@ inline auto loadResource(const std::string& path, Args... args) -> T
     static_assert(false, "No resource loader found for type T");
 }
 
+/**
+ * Built-in loader for memory-mapped files. The cached resource shares the mapping, so handing out the bytes never
+ * copies and the file is only read as far as it is touched.
+ */
+template <>
+inline auto loadResource<MappedFile>(const std::string& path) -> MappedFile
+{
+    return MappedFile{path};
+}
+
+// configuration of ResourceManager::prefetch
+struct PrefetchConfig
+{
+    // number of resources loaded in parallel. 0 uses the number of hardware threads
+    size_t max_concurrency = 0;
+    // called from the loading threads after each resource with (finished, total)
+    std::function<void(size_t, size_t)> progress;
+
+    // monadic
+    PrefetchConfig& withMaxConcurrency(size_t concurrency)
+    {
+        max_concurrency = concurrency;
+        return *this;
+    }
+
+    PrefetchConfig& withProgress(std::function<void(size_t, size_t)> callback)
+    {
+        progress = std::move(callback);
+        return *this;
+    }
+};
+
 template <typename Locator>
 class ResourceManager
 {
@@ -34,10 +78,17 @@ public:
     std::shared_ptr<T> load(const std::string& uri)
     {
         if (!_locator.contains(uri)) { throw std::runtime_error("Locator does not contain uri"); }
+        if constexpr (std::is_same_v<T, MappedFile> && requires { _locator.open_impl(uri); })
+        {
+            // the locator already holds the bytes, hand out a view instead of going through the file system
+            return _cache.retrieve<T>(uri, [this](const std::string& u) { return _locator.open(u); });
+        }
         auto path = (_locator.locate(uri)).string();
-        return _cache.retrieve<T>(uri, [path]([[maybe_unused]] const std::string& _) {
+        auto resource = _cache.retrieve<T>(uri, [path]([[maybe_unused]] const std::string& _) {
             return std::move(pg::foundation::loadResource<T>(path));
         });
+        trackReload<T>(uri, path, [path] { return pg::foundation::loadResource<T>(path); });
+        return resource;
     }
 
     template <class T, typename... Args>
@@ -45,16 +96,217 @@ public:
     {
         if (!_locator.contains(uri)) { throw std::runtime_error("Locator does not contain uri"); }
         auto path = (_locator.locate(uri)).string();
-        return _cache.retrieve<T>(uri, [path, &args...]([[maybe_unused]] const std::string& _) {
-            return pg::foundation::loadResource<T, Args...>(path, std::forward<Args>(args)...);
-        });
+        auto retrieve = [&] {
+            return _cache.retrieve<T>(uri, [path, &args...]([[maybe_unused]] const std::string& _) {
+                return pg::foundation::loadResource<T, Args...>(path, std::forward<Args>(args)...);
+            });
+        };
+        if constexpr ((std::is_copy_constructible_v<std::decay_t<Args>> && ...))
+        {
+            // reloading needs its own copy of the arguments, taken before they are forwarded to the first load
+            auto reload = [path, ... copies = std::decay_t<Args>(args)]() mutable {
+                return pg::foundation::loadResource<T, Args...>(path, copies...);
+            };
+            auto resource = retrieve();
+            trackReload<T>(uri, path, std::move(reload));
+            return resource;
+        }
+        else { return retrieve(); }
+    }
+
+    /**
+     * \brief load a set of resources of the same type in parallel and put them into the cache.
+     * Resources already cached are skipped. Blocks until all resources are loaded, the first failure is rethrown after
+     * the remaining resources have been processed.
+     * \example:
+     * manager.prefetch<Sound>(manifest.group("sounds"), PrefetchConfig{.max_concurrency = manifest.concurrency});
+     */
+    template <class T, std::ranges::input_range Uris>
+    void prefetch(Uris&& uris, PrefetchConfig&& config = {})
+    {
+        constexpr bool opens_from_memory = std::is_same_v<T, MappedFile> && requires { _locator.open_impl(""); };
+
+        // resolve up front, locators are not required to be thread safe. This includes opening resources the locator
+        // serves from memory, which is only a lookup anyway
+        struct Pending
+        {
+            std::string        uri;
+            std::string        path;
+            std::shared_ptr<T> opened;
+        };
+        std::vector<Pending>            pending;
+        std::unordered_set<std::string> seen;
+        for (const auto& entry : uris)
+        {
+            std::string uri{entry};
+            if (_cache.has(uri) || !seen.insert(uri).second) { continue; }
+            if (!_locator.contains(uri)) { throw std::runtime_error("Locator does not contain uri"); }
+            auto path = (_locator.locate(uri)).string();
+            pending.push_back({std::move(uri), std::move(path), nullptr});
+            if constexpr (opens_from_memory)
+            {
+                pending.back().opened = std::make_shared<T>(_locator.open(pending.back().uri));
+            }
+        }
+        if (pending.empty()) { return; }
+
+        auto concurrency = config.max_concurrency != 0 ? config.max_concurrency : std::thread::hardware_concurrency();
+        concurrency = std::clamp<size_t>(concurrency, 1, pending.size());
+
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> finished{0};
+        std::mutex          cache_mutex;
+        std::exception_ptr  first_error;
+        auto*               statistics = _cache.statisticsFor<T>();
+
+        auto worker = [&] {
+            for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < pending.size();
+                 i = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                const auto& [uri, path, opened] = pending[i];
+                try
+                {
+                    const auto         start = ResourceStatistics::Clock::now();
+                    std::shared_ptr<T> resource = opened;
+                    if (!resource) { resource = std::make_shared<T>(pg::foundation::loadResource<T>(path)); }
+                    if (statistics != nullptr)
+                    {
+                        statistics->recordMiss();
+                        statistics->recordLoad(ResourceStatistics::Clock::now() - start);
+                    }
+
+                    std::lock_guard lk(cache_mutex);
+                    _cache.insert<T>(uri, std::move(resource));
+                }
+                catch (...)
+                {
+                    std::lock_guard lk(cache_mutex);
+                    if (!first_error) { first_error = std::current_exception(); }
+                }
+                auto done = finished.fetch_add(1, std::memory_order_relaxed) + 1;
+                if (config.progress) { config.progress(done, pending.size()); }
+            }
+        };
+        {
+            // the calling thread takes part in loading
+            std::vector<std::jthread> workers;
+            for (size_t i = 1; i < concurrency; ++i)
+            {
+                workers.emplace_back(worker);
+            }
+            worker();
+        }
+        for (const auto& [uri, path, _] : pending)
+        {
+            trackReload<T>(uri, path, [path] { return pg::foundation::loadResource<T>(path); });
+        }
+        if (first_error) { std::rethrow_exception(first_error); }
+    }
+
+    /**
+     * \brief watch the files of resources loaded from now on and reload them when they change (Linux only).
+     * Reloads are applied by processReloads(), so the cache is only ever modified by the thread owning the manager.
+     */
+    void enableHotReload(ResourceWatcher::Config&& config = ResourceWatcher::default_config())
+    {
+        if (!_watcher) { _watcher = std::make_unique<ResourceWatcher>(std::move(config)); }
+    }
+
+    /**
+     * \brief reload all resources whose files changed. To be called periodically, e.g. once per frame.
+     * Subsequent loads return the new version, holders of the old one keep it until they reload.
+     * The first failing reload is rethrown after all others have been processed, the old version stays cached.
+     * \return number of reloaded resources
+     */
+    size_t processReloads()
+    {
+        if (!_watcher) { return 0; }
+        size_t             reloaded = 0;
+        std::exception_ptr first_error;
+        for (const auto& uri : _watcher->takeChanged())
+        {
+            auto reloader = _reloaders.find(uri);
+            if (reloader == _reloaders.end()) { continue; }
+            try
+            {
+                reloader->second(_cache);
+            }
+            catch (...)
+            {
+                if (!first_error) { first_error = std::current_exception(); }
+                continue;
+            }
+            auto generation = ++_generations[uri];
+            ++reloaded;
+            for (const auto& callback : _reload_callbacks)
+            {
+                callback(uri, generation);
+            }
+        }
+        if (first_error) { std::rethrow_exception(first_error); }
+        return reloaded;
+    }
+
+    // number of times a resource was reloaded, a cheap way for consumers to check whether to swap in the new version
+    uint64_t generation(const std::string& uri) const
+    {
+        auto it = _generations.find(uri);
+        return it != _generations.end() ? it->second : 0;
+    }
+
+    // called by processReloads with (uri, generation) for each reloaded resource
+    void onReload(std::function<void(const std::string&, uint64_t)> callback)
+    {
+        _reload_callbacks.emplace_back(std::move(callback));
+    }
+
+    // remove a resource from the cache and stop watching it
+    void evict(const std::string& uri)
+    {
+        _cache.evict(uri);
+        _reloaders.erase(uri);
+        _unwatchable.erase(uri);
+        if (_watcher) { _watcher->unwatch(uri); }
+    }
+
+    // start collecting hit/miss, load time and memory statistics per resource type
+    void enableStatistics() { _cache.enableStatistics(); }
+
+    // nullptr if statistics are not enabled
+    const CacheStatistics* statistics() const { return _cache.statistics(); }
+
+    // snapshot of the statistics as JSON, an empty object if statistics are not enabled
+    nlohmann::json statisticsJson() const
+    {
+        return _cache.statistics() != nullptr ? _cache.statistics()->toJson() : nlohmann::json::object();
     }
 
     Locator& getLocator() { return _locator; }
 
 private:
-    Locator                       _locator;
-    pg::foundation::ResourceCache _cache;
+    // to be called after the resource was loaded successfully, so failed loads leave nothing behind
+    template <class T, typename Make>
+    void trackReload(const std::string& uri, const std::string& path, Make&& make)
+    {
+        if (!_watcher || _reloaders.contains(uri) || _unwatchable.contains(uri)) { return; }
+        // remember failed watches, retrying them would cost a syscall on every load. evict() allows a new attempt
+        if (!_watcher->watch(uri, path))
+        {
+            _unwatchable.insert(uri);
+            return;
+        }
+        _reloaders.emplace(uri, [uri, make = std::forward<Make>(make)](ResourceCache& cache) mutable {
+            cache.replace<T>(uri, std::make_shared<T>(make()));
+        });
+    }
+
+    Locator                                                              _locator;
+    pg::foundation::ResourceCache                                        _cache;
+    std::unique_ptr<ResourceWatcher>                                     _watcher;
+    std::unordered_map<std::string, std::function<void(ResourceCache&)>> _reloaders;
+    std::unordered_set<std::string>                                      _unwatchable; //< uris the watcher rejected
+    std::unordered_map<std::string, uint64_t>                            _generations;
+    std::vector<std::function<void(const std::string&, uint64_t)>>       _reload_callbacks;
 };
 
 template <typename Locator>
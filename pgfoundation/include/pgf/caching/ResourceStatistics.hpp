@@ -0,0 +1,131 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include <pgf/filesystem/MappedFile.hpp>
+
+namespace pg::foundation {
+
+/**
+ * Memory attributed to a cached resource for the bytes_resident statistic. Defaults to the size of the object itself,
+ * overload for resources owning additional memory.
+ */
+template <typename Resource>
+inline size_t resourceFootprint(const Resource& /*resource*/)
+{
+    return sizeof(Resource);
+}
+
+inline size_t resourceFootprint(const MappedFile& file)
+{
+    return file.size();
+}
+
+/**
+ * Counters of a single resource type. Kept in relaxed atomics: they are only statistics and never used to synchronize,
+ * so recording is cheap even when resources are loaded from several threads.
+ */
+struct ResourceStatistics
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Snapshot
+    {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t loads = 0;
+        uint64_t load_time_ns = 0;     //< accumulated
+        uint64_t max_load_time_ns = 0;
+        uint64_t bytes_resident = 0;
+        uint64_t evictions = 0;
+
+        double hitRatio() const
+        {
+            return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+        }
+
+        Snapshot& operator+=(const Snapshot& rhs);
+    };
+
+    void recordHit() { hits.fetch_add(1, std::memory_order_relaxed); }
+
+    void recordMiss() { misses.fetch_add(1, std::memory_order_relaxed); }
+
+    void recordLoad(Clock::duration duration);
+
+    void recordResident(size_t bytes) { bytes_resident.fetch_add(bytes, std::memory_order_relaxed); }
+
+    void recordRelease(size_t bytes) { bytes_resident.fetch_sub(bytes, std::memory_order_relaxed); }
+
+    void recordEviction(size_t bytes)
+    {
+        evictions.fetch_add(1, std::memory_order_relaxed);
+        recordRelease(bytes);
+    }
+
+    Snapshot snapshot() const;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> loads{0};
+    std::atomic<uint64_t> load_time_ns{0};
+    std::atomic<uint64_t> max_load_time_ns{0};
+    std::atomic<uint64_t> bytes_resident{0};
+    std::atomic<uint64_t> evictions{0};
+};
+
+void to_json(nlohmann::json& json, const ResourceStatistics::Snapshot& snapshot);
+
+/**
+ * Statistics of a cache, one set of counters per resource type.
+ */
+class CacheStatistics
+{
+public:
+    template <typename Resource>
+    ResourceStatistics& forType()
+    {
+        const std::type_index type{typeid(Resource)};
+        {
+            std::shared_lock lk(_mutex);
+            if (auto it = _types.find(type); it != _types.end()) { return *it->second.statistics; }
+        }
+        std::unique_lock lk(_mutex);
+        auto&            entry = _types[type];
+        if (!entry.statistics)
+        {
+            entry.name = typeName(type);
+            entry.statistics = std::make_unique<ResourceStatistics>();
+        }
+        return *entry.statistics;
+    }
+
+    // summed up over all types
+    ResourceStatistics::Snapshot total() const;
+
+    /**
+     * \brief snapshot of all counters
+     * \example: {"total": {...}, "types": {"MappedFile": {"hits": 3, "misses": 1, "hit_ratio": 0.75, ...}}}
+     */
+    nlohmann::json toJson() const;
+
+private:
+    struct Entry
+    {
+        std::string                         name;
+        std::unique_ptr<ResourceStatistics> statistics;
+    };
+
+    static std::string typeName(std::type_index type);
+
+    mutable std::shared_mutex                  _mutex;
+    std::unordered_map<std::type_index, Entry> _types;
+};
+} // namespace pg::foundation
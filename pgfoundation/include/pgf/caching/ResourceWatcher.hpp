@@ -0,0 +1,87 @@
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace pg::foundation {
+using namespace std::chrono_literals;
+
+/**
+ * \brief Watches resource files for changes (Linux only, inotify based).
+ *
+ * The parent directories of the watched files are observed, so editors saving by writing a temporary file and renaming
+ * it are picked up as well. Changes are debounced: a uri is only reported once its file stayed untouched for the
+ * configured duration, so a file being written in several steps is reloaded once.
+ */
+class ResourceWatcher
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config
+    {
+        Clock::duration debounce{100ms}; //< quiet time after the last change before a uri is reported
+
+        // monadic
+        Config& withDebounce(Clock::duration duration)
+        {
+            debounce = duration;
+            return *this;
+        }
+    };
+
+    static consteval Config default_config() { return Config{}; };
+
+    // \throws std::runtime_error if file watching is not supported on the platform
+    explicit ResourceWatcher(Config&& config = default_config());
+
+    ~ResourceWatcher();
+
+    ResourceWatcher(const ResourceWatcher&) = delete;
+    ResourceWatcher& operator=(const ResourceWatcher&) = delete;
+
+    /**
+     * \brief start watching the file backing a uri.
+     * \return false if the file's directory cannot be watched, e.g. for resources that are not backed by a file
+     */
+    bool watch(const std::string& uri, const std::filesystem::path& path);
+
+    void unwatch(const std::string& uri);
+
+    bool isWatched(const std::string& uri) const;
+
+    // uris whose files changed and stayed quiet for the debounce duration. Each change is reported once.
+    std::vector<std::string> takeChanged();
+
+private:
+    struct Directory
+    {
+        std::unordered_multimap<std::string, std::string> files; //< file name -> uri
+    };
+
+    struct WatchedFile
+    {
+        int         descriptor;
+        std::string file_name;
+    };
+
+    void unwatchLocked(const std::string& uri);
+
+    // forget a directory whose watch inotify removed
+    void dropDirectoryLocked(int descriptor);
+
+    void run(std::stop_token stop_token);
+
+    Config                                             _config;
+    int                                                _inotify = -1;
+    mutable std::mutex                                 _mutex;
+    std::unordered_map<int, Directory>                 _directories; //< watch descriptor -> directory
+    std::unordered_map<std::string, WatchedFile>       _files;       //< uri -> watched file
+    std::unordered_map<std::string, Clock::time_point> _pending;     //< uri -> time of the last change
+    std::jthread                                       _thread;
+};
+} // namespace pg::foundation
@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pg::foundation::console {
+
+struct Style
+{
+    static constexpr int16_t default_color = -1;
+
+    enum Attribute : uint8_t
+    {
+        Bold = 1,
+        Underline = 2,
+        Reverse = 4,
+    };
+
+    int16_t foreground = default_color; //< 256 color palette index
+    int16_t background = default_color;
+    uint8_t attributes = 0;
+
+    bool operator==(const Style&) const = default;
+};
+
+struct Cell
+{
+    char32_t codepoint = U' ';
+    Style    style;
+
+    bool operator==(const Cell&) const = default;
+};
+
+/**
+ * Double buffered cell grid for flicker free terminal output. Draw the next frame into the back buffer, present()
+ * then compares it against the frame on screen and writes only the changed cells with a single write() call.
+ * Cursor moves are skipped for consecutive cells and short gaps are overwritten instead of jumped over.
+ * Coordinates are 0 based, every codepoint occupies one cell.
+ * \example:
+ * ScreenBuffer screen(80, 24);
+ * while (running)
+ * {
+ *     screen.clear();
+ *     screen.print(0, 0, std::format("frame {}", frame), {.foreground = 2});
+ *     screen.present();
+ * }
+ */
+class ScreenBuffer
+{
+public:
+    ScreenBuffer(int width, int height);
+
+    int width() const { return _width; }
+
+    int height() const { return _height; }
+
+    // resizing discards both frames, the next present() redraws everything
+    void resize(int width, int height);
+
+    // fill the back buffer with blanks
+    void clear(Style style = {});
+
+    // cells outside the buffer are ignored
+    void put(int x, int y, char32_t codepoint, Style style = {});
+
+    // UTF-8 text from x to the right, clipped at the border. \returns the x after the text
+    int print(int x, int y, std::string_view text, Style style = {});
+
+    const Cell& at(int x, int y) const { return _back[index(x, y)]; }
+
+    // the escape sequences turning the frame on screen into the back buffer, the back buffer becomes the front
+    std::string_view render();
+
+    // render and write the frame to stdout
+    void present();
+
+    // forget what is on screen, e.g. after something else wrote to the terminal
+    void invalidate() { _full_redraw = true; }
+
+private:
+    size_t index(int x, int y) const
+    {
+        return static_cast<size_t>(y) * static_cast<size_t>(_width) + static_cast<size_t>(x);
+    }
+
+    void moveTo(int x, int y);
+
+    void applyStyle(const Style& style);
+
+    void appendCodepoint(char32_t codepoint);
+
+    int               _width;
+    int               _height;
+    std::vector<Cell> _front; //< on screen
+    std::vector<Cell> _back;  //< being drawn
+    std::string       _output;
+    bool              _full_redraw = true;
+
+    // terminal state while rendering
+    int   _cursor_x = -1; //< -1: unknown
+    int   _cursor_y = -1;
+    Style _style;
+    bool  _style_known = false;
+};
+} // namespace pg::foundation::console
@@ -7,12 +7,12 @@
 #define NOMINMAX
 
 #include <windows.h>
-#include <iostream>
 #endif
+#include <iostream>
 // for now cheap parlor trick to enable VT100 on windows
 namespace pg::foundation::console {
 
-void setupConsole()
+inline void setupConsole()
 {
 #ifdef _WIN32
     SetConsoleMode(GetStdHandle(STD_OUTPUT_HANDLE), ENABLE_PROCESSED_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
@@ -21,7 +21,7 @@ void setupConsole()
     std::cout << "\033[?1049h";
 }
 
-void setCursorVisibility(bool visible)
+inline void setCursorVisibility(bool visible)
 {
     std::cout << "\033[?25" << (visible ? "h" : "l");
 }
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pg::foundation {
+
+namespace strings {
+class PatternSet;
+}
+
+/**
+ * Result of a DirectoryScanner run: all directories and files below a root, with paths relative to the root in
+ * generic format ("textures/grass.png"). Both lists are sorted by path. The snapshot is a plain value, queries never
+ * touch the file system again.
+ */
+class DirectorySnapshot
+{
+public:
+    struct Directory
+    {
+        std::string path; //< empty for the root itself
+        uint32_t    subdirectory_count = 0;
+        uint32_t    file_count = 0;
+
+        bool isLeaf() const { return subdirectory_count == 0; }
+    };
+
+    DirectorySnapshot() = default;
+
+    DirectorySnapshot(std::filesystem::path      root,
+                      std::vector<Directory>&&   directories,
+                      std::vector<std::string>&& files);
+
+    const std::filesystem::path& root() const { return _root; }
+
+    const std::vector<Directory>& directories() const { return _directories; }
+
+    const std::vector<std::string>& files() const { return _files; }
+
+    // the scanned directory with the given relative path, nullptr if there is none
+    const Directory* findDirectory(std::string_view relative_path) const;
+
+    // \throws std::out_of_range if the directory was not scanned
+    bool isLeafDirectory(std::string_view relative_path) const;
+
+    // directories without subdirectories, the root included if it has none
+    std::vector<std::string_view> leafDirectories() const;
+
+    // files with the given extension, e.g. ".png"
+    std::vector<std::string_view> filesWithExtension(std::string_view extension, bool caseSensitive = true) const;
+
+    // files whose relative path matches a glob, see strings::WildcardPattern
+    std::vector<std::string_view> glob(std::string_view pattern, bool caseSensitive = true) const;
+
+    // files matching any pattern of the set
+    std::vector<std::string_view> glob(const strings::PatternSet& patterns) const;
+
+    // absolute path of a relative path of the snapshot
+    std::filesystem::path absolute(std::string_view relative_path) const { return _root / relative_path; }
+
+private:
+    std::filesystem::path    _root;
+    std::vector<Directory>   _directories;
+    std::vector<std::string> _files;
+};
+
+/**
+ * Recursive directory scan distributing the directories over a pool of threads. On POSIX systems entries are
+ * classified by the type readdir reports (d_type), so no entry is stat'ed unless the file system does not provide it.
+ * Symbolic links are never followed and reported as files. Directories that cannot be read are skipped.
+ * \example:
+ * auto snapshot = DirectoryScanner().scan("assets");
+ * for (auto texture : snapshot.filesWithExtension(".png")) { ... }
+ */
+class DirectoryScanner
+{
+public:
+    struct Config
+    {
+        size_t max_threads = 0; //< 0: one per hardware thread
+
+        // monadic
+        Config& withMaxThreads(size_t threads)
+        {
+            max_threads = threads;
+            return *this;
+        }
+    };
+
+    static consteval Config default_config() { return Config{}; };
+
+    explicit DirectoryScanner(Config&& config = default_config())
+      : _config(config)
+    {
+    }
+
+    // \throws std::runtime_error if root is no readable directory
+    DirectorySnapshot scan(const std::filesystem::path& root) const;
+
+private:
+    Config _config;
+};
+} // namespace pg::foundation
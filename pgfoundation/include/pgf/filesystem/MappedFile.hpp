@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+
+namespace pg::foundation {
+
+/**
+ * Read-only view of a memory-mapped file.
+ * The mapping is shared between copies and slices, it is released once the last MappedFile referencing it is gone.
+ * Pages are faulted in on access, so only the touched parts of a file are ever read from disk.
+ */
+class MappedFile
+{
+public:
+    // access pattern hints passed on to the OS
+    enum class Access
+    {
+        Normal,
+        Sequential,
+        Random,
+        WillNeed, //< start reading the pages in ahead of time
+    };
+
+    MappedFile() = default;
+
+    explicit MappedFile(const std::filesystem::path& path);
+
+    std::span<const std::byte> bytes() const { return _bytes; }
+
+    std::string_view view() const { return {reinterpret_cast<const char*>(_bytes.data()), _bytes.size()}; }
+
+    const std::byte* data() const { return _bytes.data(); }
+
+    size_t size() const { return _bytes.size(); }
+
+    bool empty() const { return _bytes.empty(); }
+
+    /**
+     * \brief get a view on a part of the mapping. The slice keeps the whole mapping alive.
+     * \throws std::out_of_range if the range exceeds the current view
+     */
+    MappedFile slice(size_t offset, size_t length) const;
+
+    // hint the expected access pattern for the current view
+    void advise(Access access) const;
+
+private:
+    struct Mapping;
+
+    std::shared_ptr<const Mapping> _mapping;
+    std::span<const std::byte>     _bytes;
+};
+
+} // namespace pg::foundation
@@ -5,7 +5,9 @@
 
 namespace pg::foundation {
 
-static bool isLeafDirectory(const std::filesystem::path& dir)
+// single level helpers, see DirectoryScanner for recursive scans of large trees
+
+inline bool isLeafDirectory(const std::filesystem::path& dir)
 {
     for (const auto& entry : std::filesystem::directory_iterator(dir))
     {
@@ -14,12 +16,12 @@ static bool isLeafDirectory(const std::filesystem::path& dir)
     return true;
 }
 
-static std::vector<std::filesystem::path> getLeafSubDirectories(const std::filesystem::path& path)
+inline std::vector<std::filesystem::path> getLeafSubDirectories(const std::filesystem::path& path)
 {
     std::vector<std::filesystem::path> subDirectories;
     for (const auto& entry : std::filesystem::directory_iterator(path))
     {
-        if (entry.is_directory() && entry.isLeafDirectory()) { subDirectories.push_back(entry.path()); }
+        if (entry.is_directory() && isLeafDirectory(entry.path())) { subDirectories.push_back(entry.path()); }
     }
     return subDirectories;
 }
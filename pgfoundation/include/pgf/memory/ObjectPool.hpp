@@ -0,0 +1,166 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pg::foundation {
+
+/**
+ * A pool handing out storage for objects of a single type from larger chunks, so objects of that type end up close
+ * together in memory. Storage is recycled through a free list and only returned to the system with the pool.
+ *
+ * The pool is reference counted: holders call retain/release and every allocated slot holds a reference as well, so
+ * the pool stays alive until the last object allocated from it is gone.
+ *
+ * Contiguous runs get chunks of their own that count their live slots. A chunk whose slots are all deallocated is kept
+ * as a spare for the next run that fits into it, spares too small for a request are freed.
+ */
+template <typename T, size_t ChunkSize = 64>
+class ObjectPool
+{
+    static_assert(ChunkSize > 0, "Must use a non-zero chunk size");
+
+public:
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // create a pool holding one reference for the caller
+    static ObjectPool* create() { return new ObjectPool(); }
+
+    // distance between two adjacent slots returned by allocateContiguous
+    static constexpr size_t stride() { return sizeof(Slot); }
+
+    // uninitialized storage for a single object
+    void* allocate()
+    {
+        std::lock_guard lk(_mutex);
+        if (_free == nullptr) { addChunk(ChunkSize, true); }
+        auto* slot = _free;
+        _free = slot->next;
+        ++_references;
+        return slot->storage;
+    }
+
+    // uninitialized storage for count objects in adjacent slots, each slot can be deallocated on its own
+    std::byte* allocateContiguous(size_t count)
+    {
+        std::lock_guard lk(_mutex);
+        auto&           chunk = acquireRun(count);
+        chunk.live = count;
+        _references += count;
+        return chunk.slots[0].storage;
+    }
+
+    void deallocate(void* storage)
+    {
+        bool last = false;
+        {
+            std::lock_guard lk(_mutex);
+            // the storage is the first member of the slot
+            auto* slot = reinterpret_cast<Slot*>(storage);
+            if (auto* run = findRun(slot)) { --run->live; }
+            else
+            {
+                slot->next = _free;
+                _free = slot;
+            }
+            last = --_references == 0;
+        }
+        if (last) { delete this; }
+    }
+
+    void retain()
+    {
+        std::lock_guard lk(_mutex);
+        ++_references;
+    }
+
+    void release()
+    {
+        bool last = false;
+        {
+            std::lock_guard lk(_mutex);
+            last = --_references == 0;
+        }
+        if (last) { delete this; }
+    }
+
+    // chunks owned by the pool, including spare chunks for contiguous runs
+    size_t chunkCount()
+    {
+        std::lock_guard lk(_mutex);
+        return _chunks.size() + _runs.size();
+    }
+
+private:
+    union Slot {
+        Slot*                next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    ObjectPool() = default;
+    ~ObjectPool() = default;
+
+    struct RunChunk
+    {
+        std::unique_ptr<Slot[]> slots;
+        size_t                  capacity;
+        size_t                  live = 0; //< slots not deallocated yet, a spare if 0
+    };
+
+    using Runs = std::map<const Slot*, RunChunk, std::less<>>; //< keyed by the first slot
+
+    Slot* addChunk(size_t count, bool make_free)
+    {
+        auto* chunk = _chunks.emplace_back(std::make_unique<Slot[]>(count)).get();
+        if (make_free)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                chunk[i].next = i + 1 < count ? &chunk[i + 1] : _free;
+            }
+            _free = chunk;
+        }
+        return chunk;
+    }
+
+    // the smallest spare chunk holding count slots, or a new chunk
+    RunChunk& acquireRun(size_t count)
+    {
+        RunChunk* best = nullptr;
+        for (auto& [_, run] : _runs)
+        {
+            if (run.live == 0 && run.capacity >= count && (best == nullptr || run.capacity < best->capacity))
+            {
+                best = &run;
+            }
+        }
+        if (best != nullptr) { return *best; }
+
+        // none of the spares fits, so they are all too small
+        std::erase_if(_runs, [](const auto& entry) { return entry.second.live == 0; });
+        auto  slots = std::make_unique<Slot[]>(count);
+        auto* first = slots.get();
+        return _runs.emplace(first, RunChunk{std::move(slots), count}).first->second;
+    }
+
+    // the run chunk containing the slot, nullptr for slots of regular chunks
+    RunChunk* findRun(const Slot* slot)
+    {
+        if (_runs.empty()) { return nullptr; }
+        auto it = _runs.upper_bound(slot);
+        if (it == _runs.begin()) { return nullptr; }
+        --it;
+        return std::less<>{}(slot, it->first + it->second.capacity) ? &it->second : nullptr;
+    }
+
+    std::mutex                           _mutex;
+    std::vector<std::unique_ptr<Slot[]>> _chunks;
+    Runs                                 _runs; //< chunks of contiguous runs
+    Slot*                                _free = nullptr;
+    size_t                               _references = 1;
+};
+} // namespace pg::foundation
@@ -0,0 +1,84 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace pg::foundation {
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ * The slots are allocated once on construction, pushing and popping never allocate. The capacity is rounded up to a
+ * power of two so positions wrap with a mask. Each side caches the other side's position and only reloads it when
+ * the ring looks full (producer) or empty (consumer), so the shared cache lines are rarely touched.
+ */
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+      : _slots(std::bit_ceil(std::max<size_t>(capacity, 1)))
+      , _mask(_slots.size() - 1)
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // producer side, false if the ring is full
+    bool tryPush(T value)
+    {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cached_head == _slots.size())
+        {
+            _cached_head = _head.load(std::memory_order_acquire);
+            if (tail - _cached_head == _slots.size()) { return false; }
+        }
+        _slots[tail & _mask] = std::move(value);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, empty if the ring is empty
+    std::optional<T> tryPop()
+    {
+        const auto head = _head.load(std::memory_order_relaxed);
+        if (head == _cached_tail)
+        {
+            _cached_tail = _tail.load(std::memory_order_acquire);
+            if (head == _cached_tail) { return std::nullopt; }
+        }
+        std::optional<T> value{std::move(_slots[head & _mask])};
+        _head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    // only a snapshot when called while the other side is active
+    size_t size() const
+    {
+        // head first: the tail read afterwards can only be further ahead, so the difference never wraps
+        const auto head = _head.load(std::memory_order_acquire);
+        const auto tail = _tail.load(std::memory_order_acquire);
+        return std::min(tail - head, _slots.size());
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t capacity() const { return _slots.size(); }
+
+private:
+    static constexpr size_t cache_line_size = 64;
+
+    std::vector<T> _slots;
+    size_t         _mask;
+
+    alignas(cache_line_size) std::atomic<size_t> _head{0}; //< next slot to pop, written by the consumer
+    size_t _cached_tail = 0;                                //< consumer's view of _tail
+
+    alignas(cache_line_size) std::atomic<size_t> _tail{0}; //< next slot to push, written by the producer
+    size_t _cached_head = 0;                                //< producer's view of _head
+};
+
+} // namespace pg::foundation
@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <nlohmann/json.hpp>
+
+namespace pg::foundation {
+
+/**
+ * Binary snapshots of YAML configs. The JSON converted from a YAML file is stored as CBOR or MessagePack in a sidecar
+ * file, later loads read the sidecar and skip YAML parsing as long as the source file is unchanged.
+ * Layout of a sidecar (native little endian):
+ *  [Header][source path][payload]
+ * A sidecar is valid if path, modification time and size of the source match and, if enabled, its content hash.
+ */
+namespace config_cache {
+enum class Format : uint32_t
+{
+    Cbor,
+    MessagePack
+};
+
+struct Header
+{
+    std::array<char, 8> magic;
+    uint32_t            version;
+    Format              format;
+    int64_t             source_mtime; //< file clock ticks
+    uint64_t            source_size;
+    uint64_t            source_hash; //< FNV-1a of the source content
+    uint64_t            path_length; //< of the absolute source path following the header
+};
+
+inline constexpr std::array<char, 8> magic{'P', 'G', 'F', 'C', 'O', 'N', 'F', '\0'};
+inline constexpr uint32_t            version = 2; //< bumped whenever the conversion changes
+} // namespace config_cache
+
+class ConfigCache
+{
+public:
+    struct Config
+    {
+        std::filesystem::path cache_directory; //< empty: the sidecar is stored next to the source
+        config_cache::Format  format = config_cache::Format::Cbor;
+        bool                  verify_hash = true; //< also compare the content hash, not only mtime and size
+
+        // monadic
+        Config& withCacheDirectory(std::filesystem::path directory)
+        {
+            cache_directory = std::move(directory);
+            return *this;
+        }
+
+        Config& withFormat(config_cache::Format new_format)
+        {
+            format = new_format;
+            return *this;
+        }
+
+        Config& withVerifyHash(bool verify)
+        {
+            verify_hash = verify;
+            return *this;
+        }
+    };
+
+    static Config default_config() { return Config{}; };
+
+    explicit ConfigCache(Config&& config = default_config());
+
+    /**
+     * \brief the config as JSON, from the sidecar if it is up to date. Otherwise the YAML is converted and the
+     * sidecar (re)written; failing to write it is not an error, the next load simply converts again.
+     * \throws std::system_error if the source cannot be read, YAML::Exception if it is malformed
+     */
+    nlohmann::json load(const std::filesystem::path& yaml);
+
+    // where the snapshot of a source is stored
+    std::filesystem::path sidecarPath(const std::filesystem::path& yaml) const;
+
+    // remove the snapshot of a source, \returns false if there was none
+    bool invalidate(const std::filesystem::path& yaml) const;
+
+    // loads served from a sidecar / converted from YAML
+    size_t hits() const { return _hits.load(std::memory_order_relaxed); }
+
+    size_t misses() const { return _misses.load(std::memory_order_relaxed); }
+
+private:
+    Config              _config;
+    std::atomic<size_t> _hits{0};
+    std::atomic<size_t> _misses{0};
+};
+} // namespace pg::foundation
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <format>
+#include <iosfwd>
+#include <stdexcept>
+#include <string_view>
 #include <nlohmann/json.hpp>
 #include <yaml-cpp/yaml.h>
 
@@ -10,14 +14,17 @@
 namespace pg::foundation {
 namespace internal {
 
+/**
+ * \brief JSON value of a YAML scalar, resolved with the YAML 1.2 core schema: null, bool, int (decimal, 0o octal,
+ * 0x hexadecimal), float (including .inf and .nan) or string. Integers are kept exactly as int64 or, beyond that,
+ * uint64. Quoted scalars (tag "!") and explicit !!str scalars are always strings.
+ * Infinity and NaN have no JSON representation, nlohmann::json dumps them as null.
+ */
+nlohmann::json parse_scalar(std::string_view value, std::string_view tag = "?");
+
 inline nlohmann::json parse_scalar(const YAML::Node& node)
 {
-    if (int i; YAML::convert<int>::decode(node, i)) { return i; }
-    if (double d; YAML::convert<double>::decode(node, d)) { return d; }
-    if (bool b; YAML::convert<bool>::decode(node, b)) { return b; };
-    if (std::string s; YAML::convert<std::string>::decode(node, s)) { return s; };
-
-    return nullptr;
+    return parse_scalar(node.Scalar(), node.Tag());
 }
 } // namespace internal
 
@@ -32,12 +39,14 @@ inline nlohmann::json yaml2json(const YAML::Node& root)
     case YAML::NodeType::Scalar:
         return internal::parse_scalar(root);
     case YAML::NodeType::Sequence:
+        result_node = nlohmann::json::array();
         for (auto&& node : root)
         {
             result_node.emplace_back(yaml2json(node));
         }
         break;
     case YAML::NodeType::Map:
+        result_node = nlohmann::json::object();
         for (auto&& it : root)
         {
             result_node[it.first.as<std::string>()] = yaml2json(it.second);
@@ -50,4 +59,22 @@ inline nlohmann::json yaml2json(const YAML::Node& root)
     }
     return result_node;
 }
-} // namespace pg::foundation
\ No newline at end of file
+
+/**
+ * \brief Convert the first document of a YAML stream without building a YAML::Node tree first. The JSON is built
+ * directly from the parser events, aliases are resolved by copying the anchored value.
+ * \throws YAML::ParserException for malformed YAML, std::invalid_argument for keys that are no scalars
+ * \example:
+ * std::ifstream  file("scene.yaml");
+ * nlohmann::json scene = yaml2json(file);
+ */
+nlohmann::json yaml2json(std::istream& yaml);
+
+/**
+ * \brief Convert the first document of a YAML stream and write it as compact JSON to json, without building either
+ * tree. Only anchored values are buffered (to resolve their aliases).
+ * \throws same as yaml2json(std::istream&)
+ */
+void yaml2json(std::istream& yaml, std::ostream& json);
+
+} // namespace pg::foundation
@@ -0,0 +1,122 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <pgf/streaming/StreamBuffer.hpp>
+#include <pgf/taskengine/TaskEngine.hpp>
+
+namespace pg::foundation {
+
+/**
+ * \brief Streams decoded audio from a decoder to a sink through a bounded StreamBuffer, fed by a TaskEngine.
+ *
+ * A decode thread owned by the stream fills every free chunk ahead of playback and sleeps until the next chunk is
+ * released. A refill task on the engine hands filled chunks to the sink in order, e.g. alBufferData +
+ * alSourceQueueBuffers for OpenAL, and releases them back to the pool. It returns false while there is work left, so
+ * the engine reschedules it after its interval. Only chunk_size * chunk_count bytes are ever buffered, and moving the
+ * audio data through the chunks never allocates.
+ */
+class AudioStream
+{
+public:
+    using Duration = std::chrono::high_resolution_clock::duration;
+
+    // write decoded bytes into the buffer and return how many were written, 0 marks the end of the stream
+    using Decoder = std::function<size_t(std::span<std::byte> buffer)>;
+    // take the bytes of one chunk, false if it cannot take them right now (e.g. all source buffers are queued)
+    using Sink = std::function<bool(std::span<const std::byte> bytes)>;
+
+    struct Config
+    {
+        StreamBuffer::Config buffer{};
+        Duration             refill_interval{5ms}; //< delay before feeding the sink again once it is saturated
+
+        // monadic
+        Config& withBuffer(StreamBuffer::Config cfg)
+        {
+            buffer = cfg;
+            return *this;
+        }
+
+        Config& withRefillInterval(Duration interval)
+        {
+            refill_interval = interval;
+            return *this;
+        }
+    };
+
+    static consteval Config default_config() { return Config{}; };
+
+    AudioStream(Decoder decoder, Sink sink, Config&& cfg = default_config());
+
+    // stops the stream, see stop()
+    ~AudioStream();
+
+    AudioStream(const AudioStream&) = delete;
+    AudioStream& operator=(const AudioStream&) = delete;
+
+    /**
+     * \brief start the decode thread and add the refill task to the engine
+     * \throws std::logic_error if the stream was started before
+     */
+    void start(TaskEngine& engine);
+
+    /**
+     * \brief stop decoding and feeding the sink, buffered chunks are dropped
+     * Waits for a running decode and refill, so neither the decoder nor the sink is called once this returns. The
+     * refill task ends on its next run. Must not be called from the decoder or the sink.
+     */
+    void stop();
+
+    // the decoder reached the end of the stream and all its bytes were handed to the sink
+    bool finished() const { return _state->finished.load(std::memory_order_acquire); }
+
+    uint64_t bytesDecoded() const { return _state->bytes_decoded.load(std::memory_order_relaxed); }
+
+    uint64_t bytesDelivered() const { return _state->bytes_delivered.load(std::memory_order_relaxed); }
+
+    // refill runs that found no decoded chunk before the end of the stream
+    uint64_t underruns() const { return _state->underruns.load(std::memory_order_relaxed); }
+
+    const StreamBuffer& buffer() const { return _state->buffer; }
+
+private:
+    // shared with the refill task, which may run once more after the stream is gone
+    struct State
+    {
+        State(Decoder&& stream_decoder, Sink&& stream_sink, StreamBuffer::Config&& buffer_config)
+          : decoder(std::move(stream_decoder))
+          , sink(std::move(stream_sink))
+          , buffer(std::move(buffer_config))
+        {
+        }
+
+        void decode();
+        bool refill();
+
+        Decoder      decoder;
+        Sink         sink;
+        StreamBuffer buffer;
+        StreamChunk* pending = nullptr; //< chunk the sink refused, only touched by the refill task
+        std::mutex   refill_mutex;      //< held while the refill task runs, so stop() can wait for it
+
+        std::atomic<bool>     stopped{false};
+        std::atomic<uint64_t> released{0}; //< chunks returned to the pool, the decode thread waits on it
+        std::atomic<bool>     finished{false};
+        std::atomic<uint64_t> bytes_decoded{0};
+        std::atomic<uint64_t> bytes_delivered{0};
+        std::atomic<uint64_t> underruns{0};
+    };
+
+    Config                 _config;
+    std::shared_ptr<State> _state;
+    std::jthread           _decode_thread;
+    bool                   _started = false;
+};
+
+} // namespace pg::foundation
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+#include <pgf/memory/SpscRing.hpp>
+
+namespace pg::foundation {
+
+// a fixed-size buffer of a StreamBuffer, filled by the producer and handed to the consumer
+struct StreamChunk
+{
+    std::span<std::byte> data;                 //< the whole buffer, owned by the StreamBuffer
+    size_t               size = 0;             //< bytes of data that are filled
+    bool                 end_of_stream = false; //< last chunk of the stream, carries no data
+
+    std::span<const std::byte> bytes() const { return data.first(size); }
+};
+
+/**
+ * \brief Bounded buffer of pooled chunks between one producer and one consumer thread.
+ *
+ * All chunks are allocated in one block on construction. The producer acquires free chunks, fills and commits them,
+ * the consumer takes them in order and releases them back. Both directions go through lock-free SPSC rings, so
+ * neither side allocates or blocks and the memory in flight never exceeds chunk_size * chunk_count.
+ */
+class StreamBuffer
+{
+public:
+    struct Config
+    {
+        size_t chunk_size = 16 * 1024; //< bytes per chunk
+        size_t chunk_count = 8;        //< chunks in the pool
+
+        // monadic
+        Config& withChunkSize(size_t size)
+        {
+            chunk_size = size;
+            return *this;
+        }
+
+        Config& withChunkCount(size_t count)
+        {
+            chunk_count = count;
+            return *this;
+        }
+    };
+
+    static consteval Config default_config() { return Config{}; };
+
+    // \throws std::invalid_argument if chunk_size or chunk_count is 0
+    StreamBuffer(Config&& cfg = default_config());
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // producer side: an empty chunk to fill, nullptr if all chunks are in flight
+    StreamChunk* acquire();
+
+    // producer side: hand a filled chunk to the consumer
+    void commit(StreamChunk* chunk);
+
+    // consumer side: the next filled chunk in commit order, nullptr if none is ready
+    StreamChunk* next();
+
+    // consumer side: return a consumed chunk to the pool
+    void release(StreamChunk* chunk);
+
+    // chunks committed but not taken yet, a snapshot while the other side is active
+    size_t buffered() const { return _filled.size(); }
+
+    size_t chunkSize() const { return _config.chunk_size; }
+
+    size_t chunkCount() const { return _config.chunk_count; }
+
+private:
+    Config                       _config;
+    std::unique_ptr<std::byte[]> _memory;
+    std::vector<StreamChunk>     _chunks;
+    SpscRing<StreamChunk*>       _free;   //< consumer -> producer
+    SpscRing<StreamChunk*>       _filled; //< producer -> consumer
+};
+
+} // namespace pg::foundation
@@ -1,17 +1,23 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
-#include <cstring>
-#include <ranges>
+#include <compare>
+#include <cstdint>
+#include <format>
+#include <functional>
 #include <stdexcept>
 #include <string>
-#include <format>
+#include <string_view>
+#include <type_traits>
 
 namespace pg::foundation::strings {
 
 /**
  * String-like interface to an fixed length identifier. The \0 character is not included if the input is either only the
  * \0 character or uses up the capacity
+ * The layout is the length followed by the zero padded characters, so instances are trivially copyable (memcpy/bulk
+ * serialization is fine) and compare as fixed width blocks.
  * TODO: interop between different sizes.
  */
 template <size_t LENGTH>
@@ -20,47 +26,51 @@ class FixedLengthString
     static_assert(LENGTH > 0, "Must use a non-zero value for length");
 
 public:
-    FixedLengthString() { content[0] = '\0'; }
+    // smallest type holding the length
+    using SizeType = std::conditional_t<LENGTH <= UINT8_MAX, uint8_t,
+                                        std::conditional_t<LENGTH <= UINT16_MAX, uint16_t, uint32_t>>;
 
-    FixedLengthString(const FixedLengthString& rhs)
-    {
-        std::ranges::copy(rhs.content, content.begin());
-        content_view = normalize(std::string_view(content));
-    }
+    constexpr FixedLengthString() = default;
 
-    explicit(false) FixedLengthString(std::string_view s)
+    constexpr explicit(false) FixedLengthString(std::string_view s)
     {
         if (s.length() > LENGTH) { throw std::out_of_range(std::format("{} too long for FixedLength<{}>", s, LENGTH)); }
-        auto length_to_consider = std::min(s.find_first_of('\0'), s.length());
-
-        content[std::min(content.size() - 1, s.length())] = '\0';
-        std::ranges::copy_n(s.begin(), length_to_consider, content.begin());
-
-        content_view = std::string_view(content.data(), length_to_consider);
+        s = normalize(s);
+        std::ranges::copy(s, _content.begin());
+        _length = static_cast<SizeType>(s.length());
     }
 
-    explicit(false) FixedLengthString(const std::string& s)
+    constexpr explicit(false) FixedLengthString(const std::string& s)
       : FixedLengthString(std::string_view(s)){};
 
-    explicit(false) FixedLengthString(const char* const s)
+    constexpr explicit(false) FixedLengthString(const char* const s)
       : FixedLengthString(std::string_view(s)){};
 
-    explicit(false) operator std::string() const { return std::string(content_view); }
+    explicit(false) operator std::string() const { return std::string(view()); }
+
+    explicit(false) operator const char*() const { return _content.data(); }
+
+    constexpr explicit(true) operator std::string_view() const { return view(); }
 
-    explicit(false) operator const char*() const { return content_view.data(); }
+    constexpr std::string_view view() const { return {_content.data(), _length}; }
 
-    explicit(true) operator std::string_view() const { return content_view; }
+    constexpr bool operator==(std::string_view rhs) const { return normalize(rhs) == view(); }
 
-    bool operator==(std::string_view rhs) const { return normalize(rhs) == content_view; }
+    constexpr auto operator<=>(const std::string_view& rhs) const { return view() <=> normalize(rhs); }
 
-    auto operator<=>(const std::string_view& rhs) const { return content_view <=> normalize(rhs); }
+    constexpr size_t size() const { return _length; }
 
-    size_t size() const { return content_view.size(); }
+    constexpr bool empty() const { return _length == 0; }
 
-    const auto* data() const { return content.data(); };
+    static constexpr size_t capacity() { return LENGTH; }
+
+    constexpr const auto* data() const { return _content.data(); };
 
 private:
-    static std::string_view normalize(std::string_view rhs)
+    template <size_t L>
+    friend constexpr bool operator==(const FixedLengthString<L>& lhs, const FixedLengthString<L>& rhs);
+
+    static constexpr std::string_view normalize(std::string_view rhs)
     {
         auto length_to_consider = std::min(rhs.find_first_of('\0'), rhs.length());
         auto rhs_norm = std::string_view(rhs.data(), length_to_consider);
@@ -68,23 +78,33 @@ private:
     }
 
 private:
-    std::array<char, LENGTH> content;
-    std::string_view         content_view;
+    SizeType                 _length = 0;
+    std::array<char, LENGTH> _content{};
 };
 
 /*
  * We need to specialize this to avoid char* comparison to be induced
+ * The padding is always zero, so equal strings are equal blocks of bytes
  */
 template <size_t L>
-bool operator==(const FixedLengthString<L>& lhs, const FixedLengthString<L>& rhs)
+constexpr bool operator==(const FixedLengthString<L>& lhs, const FixedLengthString<L>& rhs)
 {
-    return std::string_view(lhs) == std::string_view(rhs);
+    return lhs._length == rhs._length && lhs._content == rhs._content;
 }
 
 template <size_t L>
-auto operator<=>(const FixedLengthString<L>& lhs, const FixedLengthString<L>& rhs)
+constexpr auto operator<=>(const FixedLengthString<L>& lhs, const FixedLengthString<L>& rhs)
 {
-    return lhs <=> std::string_view(rhs);
+    return lhs.view() <=> rhs.view();
 }
 
-} // namespace pg::foundation::strings
\ No newline at end of file
+} // namespace pg::foundation::strings
+
+template <size_t L>
+struct std::hash<pg::foundation::strings::FixedLengthString<L>>
+{
+    size_t operator()(const pg::foundation::strings::FixedLengthString<L>& s) const noexcept
+    {
+        return std::hash<std::string_view>{}(s.view());
+    }
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace pg::foundation::strings {
+
+/**
+ * \brief Many glob patterns ('*' and '?', see WildcardPattern) compiled into a single bit parallel automaton.
+ * A single pass over the input evaluates all patterns at once, each character costs one AND/OR per 64 pattern
+ * characters instead of one match per pattern.
+ * \example:
+ * PatternSet excludes({"*.tmp", "*.bak", "*~"});
+ * if (excludes.matchesAny(name)) { continue; }
+ */
+class PatternSet
+{
+public:
+    explicit PatternSet(bool caseSensitive = true)
+      : _case_sensitive(caseSensitive)
+    {
+    }
+
+    PatternSet(std::initializer_list<std::string_view> patterns, bool caseSensitive = true);
+
+    // \returns the index of the added pattern, indices are assigned in order
+    size_t add(std::string_view pattern);
+
+    bool matchesAny(std::string_view s) const { return firstMatch(s).has_value(); }
+
+    // index of the first pattern (in order of addition) that matches
+    std::optional<size_t> firstMatch(std::string_view s) const;
+
+    // indices of all matching patterns in ascending order
+    std::vector<size_t> allMatches(std::string_view s) const;
+
+    size_t size() const { return _accept_bits.size(); }
+
+    bool empty() const { return _accept_bits.empty(); }
+
+private:
+    using Word = uint64_t;
+    using States = std::vector<Word>;
+    static constexpr size_t word_bits = 64;
+
+    // active states after consuming all of s, accepting states only
+    States run(std::string_view s) const;
+
+    void setBit(States& bits, size_t bit);
+
+    size_t                             _bit_count = 0;
+    std::vector<std::array<Word, 256>> _char_masks;  //< per word: the states entered by consuming a character
+    States                             _start;       //< per pattern the state before its first element
+    States                             _stars;       //< states looping on any character
+    States                             _accept;      //< per pattern the state after its last element
+    std::vector<size_t>                _accept_bits; //< per pattern index of its accepting state
+    bool                               _case_sensitive = true;
+};
+} // namespace pg::foundation::strings
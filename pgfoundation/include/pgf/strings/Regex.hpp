@@ -0,0 +1,113 @@
+#pragma once
+#include <list>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace pg::foundation::strings {
+
+/**
+ * \brief A regular expression compiled once (ECMAScript grammar) for repeated matching against string views.
+ * \example:
+ * RegexPattern pattern("^tile_[0-9]+$");
+ * pattern.search("tile_12"); // true
+ */
+class RegexPattern
+{
+public:
+    explicit RegexPattern(std::string_view pattern,
+                          std::regex::flag_type flags = std::regex::ECMAScript | std::regex::optimize)
+      : _pattern(pattern)
+      , _regex(_pattern, flags)
+    {
+    }
+
+    // true if any part of s matches
+    bool search(std::string_view s) const { return std::regex_search(s.begin(), s.end(), _regex); }
+
+    // true if all of s matches
+    bool matches(std::string_view s) const { return std::regex_match(s.begin(), s.end(), _regex); }
+
+    const std::string& pattern() const { return _pattern; }
+
+    const std::regex& regex() const { return _regex; }
+
+private:
+    std::string _pattern;
+    std::regex  _regex;
+};
+
+/**
+ * \brief Thread safe cache of compiled patterns keyed by the pattern text, the least recently used pattern is dropped
+ * once the capacity is reached. Patterns are handed out as shared pointers, so dropping one never invalidates a user.
+ * \throws std::regex_error from get() for invalid patterns, those are not cached
+ */
+class RegexCache
+{
+public:
+    using Pattern = std::shared_ptr<const RegexPattern>;
+
+    explicit RegexCache(size_t capacity = 64)
+      : _capacity(capacity == 0 ? 1 : capacity)
+    {
+    }
+
+    Pattern get(std::string_view pattern)
+    {
+        {
+            std::lock_guard lk(_mutex);
+            if (auto it = _index.find(pattern); it != _index.end())
+            {
+                _lru.splice(_lru.begin(), _lru, it->second);
+                return *it->second;
+            }
+        }
+        // compile outside of the lock, a concurrent miss on the same pattern only costs a second compilation
+        auto compiled = std::make_shared<const RegexPattern>(pattern);
+
+        std::lock_guard lk(_mutex);
+        if (auto it = _index.find(pattern); it != _index.end()) { return *it->second; }
+        if (_lru.size() >= _capacity)
+        {
+            _index.erase(_lru.back()->pattern());
+            _lru.pop_back();
+        }
+        _lru.push_front(compiled);
+        _index.emplace(compiled->pattern(), _lru.begin());
+        return compiled;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard lk(_mutex);
+        return _lru.size();
+    }
+
+    size_t capacity() const { return _capacity; }
+
+    void clear()
+    {
+        std::lock_guard lk(_mutex);
+        _index.clear();
+        _lru.clear();
+    }
+
+    // process wide cache used by strings::matches
+    static RegexCache& global()
+    {
+        static RegexCache cache;
+        return cache;
+    }
+
+private:
+    using Lru = std::list<Pattern>; //< most recently used first
+
+    mutable std::mutex                                  _mutex;
+    size_t                                              _capacity;
+    Lru                                                 _lru;
+    std::unordered_map<std::string_view, Lru::iterator> _index; //< keys view into the patterns held by _lru
+};
+} // namespace pg::foundation::strings
@@ -0,0 +1,152 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace pg::foundation::strings {
+
+using SymbolId = uint32_t;
+
+/**
+ * \brief Handle to a string interned in a StringPool. Equal strings of the same pool are the same symbol, so comparison
+ * is a pointer comparison and the hash is computed once when interning. A default constructed symbol is the empty null
+ * symbol. Symbols stay valid as long as their pool.
+ */
+class Symbol
+{
+public:
+    Symbol() = default;
+
+    SymbolId id() const { return _entry ? _entry->id : invalid_id; }
+
+    std::string_view view() const
+    {
+        return _entry ? std::string_view{_entry->data(), _entry->length} : std::string_view{};
+    }
+
+    const char* c_str() const { return _entry ? _entry->data() : ""; }
+
+    size_t hash() const { return _entry ? _entry->hash : 0; }
+
+    size_t size() const { return _entry ? _entry->length : 0; }
+
+    explicit operator bool() const { return _entry != nullptr; }
+
+    explicit(true) operator std::string_view() const { return view(); }
+
+    bool operator==(const Symbol& rhs) const = default;
+
+    static constexpr SymbolId invalid_id = UINT32_MAX;
+
+private:
+    friend class StringPool;
+
+    // header of a string in the arena, the zero terminated characters follow directly
+    struct Entry
+    {
+        size_t   hash;
+        SymbolId id;
+        uint32_t length;
+
+        const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    explicit Symbol(const Entry* entry)
+      : _entry(entry)
+    {
+    }
+
+    const Entry* _entry = nullptr;
+};
+
+/**
+ * \brief Thread safe string interning. Strings are copied once into an arena and identified by dense ids, starting at
+ * 0 in order of interning. Nothing is ever removed, the pool is meant for the bounded set of uris and keys of a
+ * program.
+ * \example:
+ * auto uri = StringPool::global().intern("textures/grass.png");
+ * std::unordered_map<Symbol, Texture> textures; // hashing and comparison never touch the characters
+ */
+class StringPool
+{
+public:
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // the symbol of str, adding it if it is not in the pool yet
+    Symbol intern(std::string_view str);
+
+    // the symbol of str or the null symbol if it was never interned
+    Symbol find(std::string_view str) const;
+
+    // \throws std::out_of_range for ids not handed out by this pool
+    Symbol symbol(SymbolId id) const;
+
+    std::string_view view(SymbolId id) const { return symbol(id).view(); }
+
+    size_t size() const;
+
+    // bytes held by the arena
+    size_t memoryUsage() const;
+
+    static StringPool& global();
+
+private:
+    using Entry = Symbol::Entry;
+
+    // lookup key, hashing once per intern/find
+    struct Key
+    {
+        std::string_view str;
+        size_t           hash;
+    };
+
+    struct Hash
+    {
+        using is_transparent = void;
+
+        size_t operator()(const Entry* entry) const { return entry->hash; }
+
+        size_t operator()(const Key& key) const { return key.hash; }
+    };
+
+    struct Equal
+    {
+        using is_transparent = void;
+
+        bool operator()(const Entry* lhs, const Entry* rhs) const { return lhs == rhs; }
+
+        bool operator()(const Key& lhs, const Entry* rhs) const
+        {
+            return lhs.hash == rhs->hash && lhs.str == std::string_view{rhs->data(), rhs->length};
+        }
+
+        bool operator()(const Entry* lhs, const Key& rhs) const { return operator()(rhs, lhs); }
+    };
+
+    // storage for an entry and its characters
+    void* allocate(size_t length);
+
+    static constexpr size_t chunk_size = 64 * 1024;
+
+    mutable std::shared_mutex                     _mutex;
+    std::unordered_set<const Entry*, Hash, Equal> _index;
+    std::vector<const Entry*>                     _entries; //< by id
+    std::vector<std::unique_ptr<std::byte[]>>     _chunks;
+    std::byte*                                    _current_chunk = nullptr;
+    size_t                                        _chunk_used = chunk_size;
+    size_t                                        _memory = 0;
+};
+} // namespace pg::foundation::strings
+
+template <>
+struct std::hash<pg::foundation::strings::Symbol>
+{
+    size_t operator()(const pg::foundation::strings::Symbol& symbol) const noexcept { return symbol.hash(); }
+};
@@ -1,16 +1,199 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace pg::foundation::strings {
 
-bool matches(const std::string& s, const std::string& pattern);
+/**
+ * \brief A glob pattern compiled once for repeated matching. '*' matches any sequence, '?' any single character, all
+ * other characters match themselves. Case insensitive matching folds ASCII letters only.
+ * \example:
+ * WildcardPattern pattern("*.PNG", false);
+ * pattern.matches("textures/grass.png"); // true
+ */
+class WildcardPattern
+{
+public:
+    explicit WildcardPattern(std::string_view pattern, bool caseSensitive = true);
+
+    bool matches(std::string_view s) const;
+
+    bool isCaseSensitive() const { return _case_sensitive; }
+
+private:
+    // literal run between stars, may contain '?'
+    struct Segment
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    bool matchesAt(std::string_view s, size_t position, const Segment& segment) const;
+
+    std::string          _pattern;        //< folded to lower case if case insensitive
+    std::vector<Segment> _segments;       //< first and last are anchored, unless there is no star at all
+    size_t               _min_length = 0; //< sum of all segment lengths
+    bool                 _has_star = false;
+    bool                 _case_sensitive = true;
+};
+
+// regex search of pattern in s, compiled patterns are kept in RegexCache::global()
+bool matches(std::string_view s, std::string_view pattern);
 
 bool matchesWildCard(const std::string& s, const std::string& wildcardPattern, bool caseSensitive = true);
 
 std::vector<std::string_view> tokenize(std::string_view str, const std::string_view delims = " ");
 
+/**
+ * \brief A set of delimiter characters. Small sets are searched with SSE2/AVX2 compares where available, larger ones
+ * with a lookup table.
+ */
+class Delimiters
+{
+public:
+    static constexpr size_t max_vectorized = 8;
+
+    explicit Delimiters(std::string_view delims);
+
+    bool contains(char c) const
+    {
+        const auto u = static_cast<unsigned char>(c);
+        return (_table[u / 64] >> (u % 64)) & 1u;
+    }
+
+    // position of the first delimiter in str at or after pos, std::string_view::npos if there is none
+    size_t findIn(std::string_view str, size_t pos) const;
+
+    // position of the first character in str at or after pos that is no delimiter, str.size() if there is none
+    size_t skipIn(std::string_view str, size_t pos) const
+    {
+        while (pos < str.size() && contains(str[pos]))
+        {
+            ++pos;
+        }
+        return pos;
+    }
+
+private:
+    std::array<uint64_t, 4>           _table{};
+    std::array<char, max_vectorized>  _chars{};
+    size_t                            _count = 0; //< distinct delimiters, only vectorized up to max_vectorized
+};
+
+/**
+ * \brief Lazy version of tokenize: yields the non empty tokens between delimiters without allocating.
+ * The iterators refer to the view, keep it alive while iterating.
+ * \example:
+ * for (std::string_view token : TokenView(line, " \t")) { ... }
+ */
+class TokenView : public std::ranges::view_interface<TokenView>
+{
+public:
+    class Iterator
+    {
+    public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        Iterator() = default;
+
+        Iterator(const TokenView* view, size_t first)
+          : _view(view)
+          , _first(first)
+          , _last(view->tokenEnd(first))
+        {
+        }
+
+        std::string_view operator*() const { return _view->_str.substr(_first, _last - _first); }
+
+        Iterator& operator++()
+        {
+            _first = _view->_delimiters.skipIn(_view->_str, _last);
+            _last = _view->tokenEnd(_first);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& rhs) const { return _first == rhs._first; }
+
+        bool operator==(std::default_sentinel_t) const { return _first == _view->_str.size(); }
+
+    private:
+        const TokenView* _view = nullptr;
+        size_t           _first = 0;
+        size_t           _last = 0;
+    };
+
+    TokenView() = default;
+
+    TokenView(std::string_view str, std::string_view delims = " ")
+      : _str(str)
+      , _delimiters(delims)
+    {
+    }
+
+    Iterator begin() const { return {this, _delimiters.skipIn(_str, 0)}; }
+
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    size_t tokenEnd(size_t first) const
+    {
+        const auto last = _delimiters.findIn(_str, first);
+        return last == std::string_view::npos ? _str.size() : last;
+    }
+
+    std::string_view _str;
+    Delimiters       _delimiters{" "};
+};
+
+// ASCII case conversion, other bytes (including UTF-8 sequences) are kept as they are
 std::string toLower(std::string_view str);
 
+std::string toUpper(std::string_view str);
+
+void toLowerInPlace(std::span<char> str);
+
+void toUpperInPlace(std::span<char> str);
+
+// ASCII case insensitive comparison
+bool equalsIgnoreCase(std::string_view lhs, std::string_view rhs);
+
+// hash consistent with equalsIgnoreCase
+size_t hashIgnoreCase(std::string_view str);
+
+/**
+ * \brief transparent functors for case insensitive containers, lookups with string views do not allocate
+ * \example:
+ * std::unordered_map<std::string, Texture, IgnoreCaseHash, IgnoreCaseEqual> textures;
+ * textures.find(std::string_view{"Textures/Grass.PNG"});
+ */
+struct IgnoreCaseHash
+{
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const { return hashIgnoreCase(str); }
+};
+
+struct IgnoreCaseEqual
+{
+    using is_transparent = void;
+
+    bool operator()(std::string_view lhs, std::string_view rhs) const { return equalsIgnoreCase(lhs, rhs); }
+};
+
 } // namespace pg::foundation::strings
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <mutex>
 #include <thread>
 #include <future>
+#include <vector>
 
 namespace pg::foundation {
 using namespace std::chrono_literals;
@@ -21,7 +22,7 @@ struct Task
     // bool execute() { return task(); }
 
     std::function<bool()> task; //< the task needs to return true if it was successful, false otherwise.
-    bool                  reschedule_on_failure = false; //< if the task fails, should it be rescheduled?
+    bool                               reschedule_on_failure = false; //< if the task fails, should it be rescheduled?
     Duration              starting_time_offset{0ms};     //< delay before executing the task
     Duration              reschedule_delay{0ms};         //< delay before rescheduling the task
 };
@@ -70,7 +71,7 @@ struct InternalTask
     }
 
     Task           job;
-    bool           async = false;
+    bool                               async = false;
     Task::Duration async_check_duration{1ms};
 
     std::shared_future<std::pair<bool, std::function<bool()>>> fut;
@@ -203,18 +204,23 @@ public:
     bool hasTimedTasks() const;
 
 private:
+    using TimedTasks = std::map<Task::TimePoint, InternalTask>;
+
     void addInternalTask(InternalTask&& task);
     void checkTimedTasks(const Task::TimePoint& time);
-    void run();
-
-    mutable std::mutex                      _mutex;
-    std::condition_variable                 _cv; //< used to notify the engine that a new task is available
-    bool                                    _task_available = false; //< flag to signal that a new task is available
-    std::deque<InternalTask>                _tasks;                  //< synchronous tasks to be executed
-    std::map<Task::TimePoint, InternalTask> _timed_tasks;            //< tasks to be executed at a specific time
-    Config                                  _config{};
-    std::jthread                            runner_thread;
-    std::jthread                            _check_thread;
+    // add a timed task, reusing the node of a fired timer if there is one. Requires _mutex to be held
+    void scheduleLocked(Task::TimePoint time, InternalTask&& task);
+    void run(std::stop_token stop_token);
+
+    mutable std::mutex                 _mutex;
+    std::condition_variable            _cv; //< used to notify the engine that a new task is available
+    bool                               _task_available = false; //< flag to signal that a new task is available
+    std::deque<InternalTask>           _tasks;                  //< synchronous tasks to be executed
+    TimedTasks                         _timed_tasks;            //< tasks to be executed at a specific time
+    std::vector<TimedTasks::node_type> _spare_timers;           //< nodes of fired timers, reused when rescheduling
+    Config                             _config{};
+    std::jthread                       runner_thread;
+    std::jthread                       _check_thread;
 }; // namespace pgf
 
 } // namespace pg::foundation
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include <pgf/caching/PackArchive.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+static_assert(std::endian::native == std::endian::little, "pack archives are stored little endian");
+
+namespace {
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// [offset, offset + length) is not within size, without overflowing on corrupt values
+constexpr bool exceeds(uint64_t offset, uint64_t length, uint64_t size)
+{
+    return offset > size || length > size - offset;
+}
+} // namespace
+
+pg::foundation::PackArchive::PackArchive(const std::filesystem::path& archive)
+  : _path(archive)
+  , _file(archive)
+{
+    pack::Header header{};
+    if (_file.size() < sizeof(header))
+    {
+        throw std::runtime_error(std::format("{} is not a pack archive", _path.string()));
+    }
+    std::memcpy(&header, _file.data(), sizeof(header));
+    if (header.magic != pack::magic) { throw std::runtime_error(std::format("{} is not a pack archive", _path.string())); }
+    if (header.version != pack::version)
+    {
+        throw std::runtime_error(std::format("{} has unsupported pack version {}", _path.string(), header.version));
+    }
+
+    const auto index_size = uint64_t{header.entry_count} * sizeof(pack::IndexEntry);
+    if (sizeof(header) + index_size > header.names_offset ||
+        exceeds(header.names_offset, header.names_size, _file.size()))
+    {
+        throw std::runtime_error(std::format("{} has a corrupt index", _path.string()));
+    }
+    // the index directly follows the header and is suitably aligned within the page aligned mapping
+    _index = {reinterpret_cast<const pack::IndexEntry*>(_file.data() + sizeof(header)), header.entry_count};
+    _names = _file.view().substr(header.names_offset, header.names_size);
+
+    for (const auto& entry : _index)
+    {
+        if (exceeds(entry.offset, entry.size, _file.size()) ||
+            exceeds(entry.name_offset, entry.name_length, _names.size()))
+        {
+            throw std::runtime_error(std::format("{} has a corrupt index entry", _path.string()));
+        }
+    }
+}
+
+pg::foundation::MappedFile pg::foundation::PackArchive::open(std::string_view uri) const
+{
+    const auto* entry = find(uri);
+    if (entry == nullptr) { throw std::out_of_range(std::format("{} does not contain {}", _path.string(), uri)); }
+    return _file.slice(entry->offset, entry->size);
+}
+
+std::vector<std::string_view> pg::foundation::PackArchive::uris() const
+{
+    std::vector<std::string_view> result;
+    result.reserve(_index.size());
+    for (const auto& entry : _index)
+    {
+        result.emplace_back(name(entry));
+    }
+    return result;
+}
+
+const pg::foundation::pack::IndexEntry* pg::foundation::PackArchive::find(std::string_view uri) const
+{
+    const auto hash = pack::hashUri(uri);
+    auto [first, last] = std::ranges::equal_range(_index, hash, {}, &pack::IndexEntry::hash);
+    // hash collisions are resolved by the name
+    auto it = std::find_if(first, last, [this, uri](const auto& entry) { return name(entry) == uri; });
+    return it != last ? &*it : nullptr;
+}
+
+std::string_view pg::foundation::PackArchive::name(const pack::IndexEntry& entry) const
+{
+    return _names.substr(entry.name_offset, entry.name_length);
+}
+
+void pg::foundation::PackWriter::add(std::string uri, std::filesystem::path source)
+{
+    _entries.emplace_back(std::move(uri), std::move(source));
+}
+
+void pg::foundation::PackWriter::addDirectory(const std::filesystem::path& root)
+{
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root))
+    {
+        if (!entry.is_regular_file()) { continue; }
+        add(entry.path().lexically_relative(root).generic_string(), entry.path());
+    }
+}
+
+void pg::foundation::PackWriter::write(const std::filesystem::path& archive, size_t alignment) const
+{
+    if (!std::has_single_bit(alignment)) { throw std::invalid_argument("Pack alignment must be a power of two"); }
+
+    std::vector<pack::IndexEntry> index;
+    std::string                   names;
+    index.reserve(_entries.size());
+    for (const auto& [uri, source] : _entries)
+    {
+        index.push_back({pack::hashUri(uri),
+                         0,
+                         std::filesystem::file_size(source),
+                         static_cast<uint32_t>(names.size()),
+                         static_cast<uint32_t>(uri.size())});
+        names += uri;
+    }
+
+    pack::Header header{pack::magic,
+                        pack::version,
+                        static_cast<uint32_t>(index.size()),
+                        sizeof(pack::Header) + index.size() * sizeof(pack::IndexEntry),
+                        names.size(),
+                        alignment};
+
+    auto offset = alignUp(header.names_offset + header.names_size, alignment);
+    for (auto& entry : index)
+    {
+        entry.offset = offset;
+        offset = alignUp(offset + entry.size, alignment);
+    }
+
+    // sort the index, the blobs are written in the original order so related files stay close together
+    std::vector<size_t> order(index.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::ranges::sort(order, [&](size_t lhs, size_t rhs) {
+        const auto& l = index[lhs];
+        const auto& r = index[rhs];
+        if (l.hash != r.hash) { return l.hash < r.hash; }
+        return _entries[lhs].first < _entries[rhs].first;
+    });
+    for (size_t i = 1; i < order.size(); ++i)
+    {
+        if (_entries[order[i - 1]].first == _entries[order[i]].first)
+        {
+            throw std::invalid_argument(std::format("Duplicate uri {} in pack", _entries[order[i]].first));
+        }
+    }
+
+    std::ofstream out(archive, std::ios::binary | std::ios::trunc);
+    if (!out) { throw std::runtime_error(std::format("Cannot write pack archive {}", archive.string())); }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (auto i : order)
+    {
+        out.write(reinterpret_cast<const char*>(&index[i]), sizeof(pack::IndexEntry));
+    }
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    std::vector<char> buffer(1 << 16);
+    for (size_t i = 0; i < index.size(); ++i)
+    {
+        // pad up to the aligned blob start
+        auto position = static_cast<uint64_t>(out.tellp());
+        std::fill_n(std::ostreambuf_iterator<char>(out), index[i].offset - position, '\0');
+
+        std::ifstream in(_entries[i].second, std::ios::binary);
+        if (!in) { throw std::runtime_error(std::format("Cannot read {}", _entries[i].second.string())); }
+        uint64_t written = 0;
+        while (in)
+        {
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            out.write(buffer.data(), in.gcount());
+            written += static_cast<uint64_t>(in.gcount());
+        }
+        if (written != index[i].size)
+        {
+            throw std::runtime_error(std::format("{} changed while packing", _entries[i].second.string()));
+        }
+    }
+    if (!out) { throw std::runtime_error(std::format("Failed writing pack archive {}", archive.string())); }
+}
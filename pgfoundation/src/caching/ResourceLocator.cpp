@@ -0,0 +1,80 @@
+#include <pgf/caching/ResourceLocator.hpp>
+#include <format>
+#include <future>
+#include <stdexcept>
+
+namespace {
+using Entries = std::vector<std::pair<std::string, std::filesystem::path>>;
+
+// collect all regular files below root/relative_directory, keyed by their generic path relative to root
+Entries scanRoot(const std::filesystem::path& root, const std::filesystem::path& relative_directory)
+{
+    Entries         entries;
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it(root / relative_directory, ec), end; !ec && it != end;
+         it.increment(ec))
+    {
+        if (!it->is_regular_file(ec)) { continue; }
+        entries.emplace_back(it->path().lexically_relative(root).generic_string(), it->path());
+    }
+    return entries;
+}
+} // namespace
+
+pg::foundation::IndexedResourceLocator::IndexedResourceLocator(std::vector<std::filesystem::path> roots)
+  : _roots(std::move(roots))
+{
+    refresh();
+}
+
+std::filesystem::path pg::foundation::IndexedResourceLocator::loc_impl(const std::string& uri) const
+{
+    auto it = _index.find(uri);
+    if (it == _index.end()) { throw std::out_of_range(std::format("No resource {} in any root", uri)); }
+    return it->second;
+}
+
+void pg::foundation::IndexedResourceLocator::refresh(const std::filesystem::path& relative_directory)
+{
+    // "." and "./" refer to the roots themselves, keys never carry such a prefix
+    auto directory = relative_directory.lexically_normal();
+    if (directory == ".") { directory.clear(); }
+
+    // each root is scanned on its own thread, the results are merged in root order so earlier roots win
+    std::vector<std::future<Entries>> scans;
+    scans.reserve(_roots.size());
+    for (const auto& root : _roots)
+    {
+        scans.emplace_back(std::async(std::launch::async, scanRoot, std::cref(root), std::cref(directory)));
+    }
+
+    if (directory.empty()) { _index.clear(); }
+    else
+    {
+        auto prefix = directory.generic_string();
+        if (!prefix.ends_with('/')) { prefix += '/'; }
+        std::erase_if(_index, [&prefix](const auto& entry) { return entry.first.starts_with(prefix); });
+    }
+
+    for (auto& scan : scans)
+    {
+        for (auto& [uri, path] : scan.get())
+        {
+            _index.try_emplace(std::move(uri), std::move(path));
+        }
+    }
+}
+
+void pg::foundation::IndexedResourceLocator::refreshUri(const std::string& uri)
+{
+    _index.erase(uri);
+    for (const auto& root : _roots)
+    {
+        auto path = root / std::filesystem::path{uri};
+        if (std::filesystem::is_regular_file(path))
+        {
+            _index.emplace(uri, std::move(path));
+            return;
+        }
+    }
+}
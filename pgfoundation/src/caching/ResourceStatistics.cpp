@@ -0,0 +1,107 @@
+#include <pgf/caching/ResourceStatistics.hpp>
+#ifdef __GNUG__
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+pg::foundation::ResourceStatistics::Snapshot& pg::foundation::ResourceStatistics::Snapshot::operator+=(
+    const Snapshot& rhs)
+{
+    hits += rhs.hits;
+    misses += rhs.misses;
+    loads += rhs.loads;
+    load_time_ns += rhs.load_time_ns;
+    max_load_time_ns = std::max(max_load_time_ns, rhs.max_load_time_ns);
+    bytes_resident += rhs.bytes_resident;
+    evictions += rhs.evictions;
+    return *this;
+}
+
+void pg::foundation::ResourceStatistics::recordLoad(Clock::duration duration)
+{
+    const auto nanoseconds = static_cast<uint64_t>(std::chrono::nanoseconds(duration).count());
+    loads.fetch_add(1, std::memory_order_relaxed);
+    load_time_ns.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    auto current = max_load_time_ns.load(std::memory_order_relaxed);
+    while (current < nanoseconds &&
+           !max_load_time_ns.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+pg::foundation::ResourceStatistics::Snapshot pg::foundation::ResourceStatistics::snapshot() const
+{
+    return {hits.load(std::memory_order_relaxed),
+            misses.load(std::memory_order_relaxed),
+            loads.load(std::memory_order_relaxed),
+            load_time_ns.load(std::memory_order_relaxed),
+            max_load_time_ns.load(std::memory_order_relaxed),
+            bytes_resident.load(std::memory_order_relaxed),
+            evictions.load(std::memory_order_relaxed)};
+}
+
+void pg::foundation::to_json(nlohmann::json& json, const ResourceStatistics::Snapshot& snapshot)
+{
+    constexpr double ns_per_ms = 1e6;
+    json = {{"hits", snapshot.hits},
+            {"misses", snapshot.misses},
+            {"hit_ratio", snapshot.hitRatio()},
+            {"loads", snapshot.loads},
+            {"load_time_ms_total", static_cast<double>(snapshot.load_time_ns) / ns_per_ms},
+            {"load_time_ms_avg",
+             snapshot.loads == 0
+                 ? 0.0
+                 : static_cast<double>(snapshot.load_time_ns) / ns_per_ms / static_cast<double>(snapshot.loads)},
+            {"load_time_ms_max", static_cast<double>(snapshot.max_load_time_ns) / ns_per_ms},
+            {"bytes_resident", snapshot.bytes_resident},
+            {"evictions", snapshot.evictions}};
+}
+
+pg::foundation::ResourceStatistics::Snapshot pg::foundation::CacheStatistics::total() const
+{
+    ResourceStatistics::Snapshot result;
+    std::shared_lock             lk(_mutex);
+    for (const auto& [_, entry] : _types)
+    {
+        result += entry.statistics->snapshot();
+    }
+    return result;
+}
+
+nlohmann::json pg::foundation::CacheStatistics::toJson() const
+{
+    nlohmann::json               types = nlohmann::json::object();
+    ResourceStatistics::Snapshot sum;
+    {
+        std::shared_lock lk(_mutex);
+        for (const auto& [_, entry] : _types)
+        {
+            auto snapshot = entry.statistics->snapshot();
+            sum += snapshot;
+            types[entry.name] = snapshot;
+        }
+    }
+    return {{"total", sum}, {"types", std::move(types)}};
+}
+
+std::string pg::foundation::CacheStatistics::typeName(std::type_index type)
+{
+#ifdef __GNUG__
+    int   status = 0;
+    char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+    if (status == 0 && demangled != nullptr)
+    {
+        std::string name{demangled};
+        std::free(demangled);
+        return name;
+    }
+#endif
+    // MSVC names are readable already but prefixed with the kind of type
+    std::string_view name{type.name()};
+    for (std::string_view prefix : {"class ", "struct "})
+    {
+        if (name.starts_with(prefix)) { name.remove_prefix(prefix.size()); }
+    }
+    return std::string{name};
+}
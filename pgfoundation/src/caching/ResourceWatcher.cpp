@@ -0,0 +1,180 @@
+#include <pgf/caching/ResourceWatcher.hpp>
+#include <stdexcept>
+#ifdef __linux__
+#include <array>
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+namespace {
+constexpr uint32_t watch_mask = IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE;
+constexpr int      poll_timeout_ms = 50; //< upper bound for noticing a stop request
+} // namespace
+
+pg::foundation::ResourceWatcher::ResourceWatcher(Config&& config)
+  : _config(config)
+  , _inotify(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+    if (_inotify < 0) { throw std::runtime_error("Cannot initialize inotify"); }
+    _thread = std::jthread{[this](std::stop_token stop_token) { run(stop_token); }};
+}
+
+pg::foundation::ResourceWatcher::~ResourceWatcher()
+{
+    _thread.request_stop();
+    _thread.join();
+    ::close(_inotify);
+}
+
+bool pg::foundation::ResourceWatcher::watch(const std::string& uri, const std::filesystem::path& path)
+{
+    auto absolute = std::filesystem::absolute(path).lexically_normal();
+    auto directory = absolute.parent_path().string();
+
+    std::lock_guard lk(_mutex);
+    unwatchLocked(uri);
+
+    // inotify hands out one descriptor per inode, so directories reached through different paths (e.g. symlinks)
+    // share their descriptor and their entry in _directories
+    auto descriptor = inotify_add_watch(_inotify, directory.c_str(), watch_mask);
+    if (descriptor < 0) { return false; }
+    auto file_name = absolute.filename().string();
+    _directories[descriptor].files.emplace(file_name, uri);
+    _files[uri] = {descriptor, std::move(file_name)};
+    return true;
+}
+
+void pg::foundation::ResourceWatcher::unwatch(const std::string& uri)
+{
+    std::lock_guard lk(_mutex);
+    unwatchLocked(uri);
+}
+
+void pg::foundation::ResourceWatcher::unwatchLocked(const std::string& uri)
+{
+    auto file_it = _files.find(uri);
+    if (file_it == _files.end()) { return; }
+
+    auto& [descriptor, file_name] = file_it->second;
+    auto& directory = _directories[descriptor];
+    auto [first, last] = directory.files.equal_range(file_name);
+    for (auto it = first; it != last; ++it)
+    {
+        if (it->second == uri)
+        {
+            directory.files.erase(it);
+            break;
+        }
+    }
+    // drop the directory watch once nothing in it is watched anymore
+    if (directory.files.empty())
+    {
+        inotify_rm_watch(_inotify, descriptor);
+        _directories.erase(descriptor);
+    }
+    _files.erase(file_it);
+    _pending.erase(uri);
+}
+
+void pg::foundation::ResourceWatcher::dropDirectoryLocked(int descriptor)
+{
+    // the watch is gone already, e.g. the directory was deleted or unmounted
+    auto directory = _directories.find(descriptor);
+    if (directory == _directories.end()) { return; }
+    for (const auto& [_, uri] : directory->second.files)
+    {
+        _files.erase(uri);
+        _pending.erase(uri);
+    }
+    _directories.erase(directory);
+}
+
+void pg::foundation::ResourceWatcher::run(std::stop_token stop_token)
+{
+    // large enough for a burst of events, inotify never splits an event over reads
+    alignas(inotify_event) std::array<char, 64 * 1024> buffer{};
+    pollfd                                            poll_fd{_inotify, POLLIN, 0};
+
+    while (!stop_token.stop_requested())
+    {
+        if (::poll(&poll_fd, 1, poll_timeout_ms) <= 0) { continue; }
+
+        auto length = ::read(_inotify, buffer.data(), buffer.size());
+        if (length <= 0) { continue; }
+
+        const auto      now = Clock::now();
+        std::lock_guard lk(_mutex);
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            if ((event->mask & IN_IGNORED) != 0)
+            {
+                dropDirectoryLocked(event->wd);
+                continue;
+            }
+            if (event->len == 0) { continue; }
+
+            auto directory = _directories.find(event->wd);
+            if (directory == _directories.end()) { continue; }
+            auto [first, last] = directory->second.files.equal_range(event->name);
+            for (auto it = first; it != last; ++it)
+            {
+                _pending[it->second] = now;
+            }
+        }
+    }
+}
+
+#else
+
+pg::foundation::ResourceWatcher::ResourceWatcher(Config&& config)
+  : _config(config)
+{
+    throw std::runtime_error("ResourceWatcher is only supported on Linux");
+}
+
+pg::foundation::ResourceWatcher::~ResourceWatcher() = default;
+
+bool pg::foundation::ResourceWatcher::watch(const std::string&, const std::filesystem::path&)
+{
+    return false;
+}
+
+void pg::foundation::ResourceWatcher::unwatch(const std::string&) {}
+
+void pg::foundation::ResourceWatcher::unwatchLocked(const std::string&) {}
+
+void pg::foundation::ResourceWatcher::dropDirectoryLocked(int) {}
+
+void pg::foundation::ResourceWatcher::run(std::stop_token) {}
+
+#endif
+
+bool pg::foundation::ResourceWatcher::isWatched(const std::string& uri) const
+{
+    std::lock_guard lk(_mutex);
+    return _files.contains(uri);
+}
+
+std::vector<std::string> pg::foundation::ResourceWatcher::takeChanged()
+{
+    const auto               now = Clock::now();
+    std::vector<std::string> changed;
+
+    std::lock_guard lk(_mutex);
+    for (auto it = _pending.begin(); it != _pending.end();)
+    {
+        if (now - it->second < _config.debounce)
+        {
+            ++it;
+            continue;
+        }
+        changed.push_back(it->first);
+        it = _pending.erase(it);
+    }
+    return changed;
+}
@@ -0,0 +1,247 @@
+#include <pgf/console/ScreenBuffer.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+// gaps up to this many cells are rewritten rather than jumped over, a cursor move costs about as many bytes
+constexpr int max_rewrite_gap = 4;
+
+constexpr char32_t replacement_character = U'\uFFFD';
+
+void appendNumber(std::string& out, int value)
+{
+    char buffer[12];
+    auto [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, end);
+}
+
+// decode one codepoint, invalid sequences yield U+FFFD and advance by one byte
+// overlong forms, surrogates and codepoints above U+10FFFF are invalid as well
+char32_t decodeUtf8(std::string_view text, size_t& position)
+{
+    const auto lead = static_cast<unsigned char>(text[position++]);
+    if (lead < 0x80) { return lead; }
+
+    int      length = 0;
+    char32_t codepoint = 0;
+    char32_t minimum = 0; //< smallest codepoint that needs this many bytes
+    if ((lead & 0xe0) == 0xc0)
+    {
+        length = 1;
+        codepoint = lead & 0x1f;
+        minimum = 0x80;
+    }
+    else if ((lead & 0xf0) == 0xe0)
+    {
+        length = 2;
+        codepoint = lead & 0x0f;
+        minimum = 0x800;
+    }
+    else if ((lead & 0xf8) == 0xf0)
+    {
+        length = 3;
+        codepoint = lead & 0x07;
+        minimum = 0x10000;
+    }
+    else { return replacement_character; }
+
+    if (position + static_cast<size_t>(length) > text.size()) { return replacement_character; }
+    for (int i = 0; i < length; ++i)
+    {
+        const auto continuation = static_cast<unsigned char>(text[position + static_cast<size_t>(i)]);
+        if ((continuation & 0xc0) != 0x80) { return replacement_character; }
+        codepoint = (codepoint << 6) | (continuation & 0x3f);
+    }
+    if (codepoint < minimum || codepoint > 0x10ffff || (codepoint >= 0xd800 && codepoint <= 0xdfff))
+    {
+        return replacement_character;
+    }
+    position += static_cast<size_t>(length);
+    return codepoint;
+}
+} // namespace
+
+pg::foundation::console::ScreenBuffer::ScreenBuffer(int width, int height)
+  : _width(0)
+  , _height(0)
+{
+    resize(width, height);
+}
+
+void pg::foundation::console::ScreenBuffer::resize(int width, int height)
+{
+    _width = std::max(width, 0);
+    _height = std::max(height, 0);
+    const auto cells = static_cast<size_t>(_width) * static_cast<size_t>(_height);
+    _front.assign(cells, Cell{});
+    _back.assign(cells, Cell{});
+    _full_redraw = true;
+}
+
+void pg::foundation::console::ScreenBuffer::clear(Style style)
+{
+    std::ranges::fill(_back, Cell{U' ', style});
+}
+
+void pg::foundation::console::ScreenBuffer::put(int x, int y, char32_t codepoint, Style style)
+{
+    if (x < 0 || y < 0 || x >= _width || y >= _height) { return; }
+    _back[index(x, y)] = {codepoint, style};
+}
+
+int pg::foundation::console::ScreenBuffer::print(int x, int y, std::string_view text, Style style)
+{
+    for (size_t position = 0; position < text.size() && x < _width;)
+    {
+        put(x++, y, decodeUtf8(text, position), style);
+    }
+    return x;
+}
+
+void pg::foundation::console::ScreenBuffer::moveTo(int x, int y)
+{
+    if (x == _cursor_x && y == _cursor_y) { return; }
+    _output += "\033[";
+    appendNumber(_output, y + 1);
+    _output += ';';
+    appendNumber(_output, x + 1);
+    _output += 'H';
+    _cursor_x = x;
+    _cursor_y = y;
+}
+
+void pg::foundation::console::ScreenBuffer::applyStyle(const Style& style)
+{
+    if (_style_known && style == _style) { return; }
+    // reset and set everything, cheaper to get right than tracking single attributes
+    _output += "\033[0";
+    if (style.attributes & Style::Bold) { _output += ";1"; }
+    if (style.attributes & Style::Underline) { _output += ";4"; }
+    if (style.attributes & Style::Reverse) { _output += ";7"; }
+    if (style.foreground != Style::default_color)
+    {
+        _output += ";38;5;";
+        appendNumber(_output, style.foreground);
+    }
+    if (style.background != Style::default_color)
+    {
+        _output += ";48;5;";
+        appendNumber(_output, style.background);
+    }
+    _output += 'm';
+    _style = style;
+    _style_known = true;
+}
+
+void pg::foundation::console::ScreenBuffer::appendCodepoint(char32_t codepoint)
+{
+    if (codepoint < 0x80)
+    {
+        // control characters would move the cursor
+        _output += codepoint < 0x20 || codepoint == 0x7f ? ' ' : static_cast<char>(codepoint);
+    }
+    else if (codepoint < 0x800)
+    {
+        _output += static_cast<char>(0xc0 | (codepoint >> 6));
+        _output += static_cast<char>(0x80 | (codepoint & 0x3f));
+    }
+    else if (codepoint < 0x10000)
+    {
+        _output += static_cast<char>(0xe0 | (codepoint >> 12));
+        _output += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+        _output += static_cast<char>(0x80 | (codepoint & 0x3f));
+    }
+    else
+    {
+        _output += static_cast<char>(0xf0 | (codepoint >> 18));
+        _output += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f));
+        _output += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+        _output += static_cast<char>(0x80 | (codepoint & 0x3f));
+    }
+}
+
+std::string_view pg::foundation::console::ScreenBuffer::render()
+{
+    _output.clear();
+    if (_full_redraw)
+    {
+        // nothing on screen can be trusted, start from a cleared screen
+        _output += "\033[0m\033[2J";
+        _style = {};
+        _style_known = true;
+        _cursor_x = -1;
+        _cursor_y = -1;
+        std::ranges::fill(_front, Cell{});
+    }
+
+    for (int y = 0; y < _height; ++y)
+    {
+        for (int x = 0; x < _width; ++x)
+        {
+            const auto& cell = _back[index(x, y)];
+            if (cell == _front[index(x, y)]) { continue; }
+
+            // rewriting a few unchanged cells in the current style is shorter than moving the cursor
+            if (y == _cursor_y && _cursor_x >= 0 && x > _cursor_x && x - _cursor_x <= max_rewrite_gap && _style_known &&
+                std::all_of(_back.begin() + static_cast<std::ptrdiff_t>(index(_cursor_x, y)),
+                            _back.begin() + static_cast<std::ptrdiff_t>(index(x, y)),
+                            [this](const Cell& skipped) { return skipped.style == _style; }))
+            {
+                for (int gap = _cursor_x; gap < x; ++gap)
+                {
+                    appendCodepoint(_back[index(gap, y)].codepoint);
+                }
+                _cursor_x = x;
+            }
+            moveTo(x, y);
+            applyStyle(cell.style);
+            appendCodepoint(cell.codepoint);
+            _front[index(x, y)] = cell;
+
+            // the cursor stays on the last column until the next character, do not rely on where it is
+            _cursor_x = x + 1 < _width ? x + 1 : -1;
+        }
+    }
+    _full_redraw = false;
+    return _output;
+}
+
+void pg::foundation::console::ScreenBuffer::present()
+{
+    const auto frame = render();
+    if (frame.empty()) { return; }
+#ifdef _WIN32
+    DWORD written = 0;
+    if (!WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), frame.data(), static_cast<DWORD>(frame.size()), &written, nullptr)
+        || written != frame.size())
+    {
+        // render() already took the frame as the front buffer, the terminal only shows part of it
+        _full_redraw = true;
+    }
+#else
+    // a single write, only repeated if the terminal accepted part of the frame
+    for (size_t offset = 0; offset < frame.size();)
+    {
+        const auto written = ::write(STDOUT_FILENO, frame.data() + offset, frame.size() - offset);
+        if (written < 0 && errno == EINTR) { continue; }
+        if (written <= 0)
+        {
+            // render() already took the frame as the front buffer, the terminal only shows part of it
+            _full_redraw = true;
+            return;
+        }
+        offset += static_cast<size_t>(written);
+    }
+#endif
+}
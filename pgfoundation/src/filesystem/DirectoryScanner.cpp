@@ -0,0 +1,238 @@
+#include <pgf/filesystem/DirectoryScanner.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <format>
+#include <mutex>
+#include <stdexcept>
+#include <iterator>
+#include <thread>
+#include <pgf/strings/PatternSet.hpp>
+#include <pgf/strings/StringTools.hpp>
+#if !defined(_WIN32)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+using Directory = pg::foundation::DirectorySnapshot::Directory;
+
+// what a worker collected, merged once all workers are done
+struct ScanResult
+{
+    std::vector<Directory>   directories;
+    std::vector<std::string> files;
+};
+
+std::string childPath(const std::string& directory, std::string_view name)
+{
+    std::string child;
+    child.reserve(directory.size() + 1 + name.size());
+    if (!directory.empty())
+    {
+        child += directory;
+        child += '/';
+    }
+    child += name;
+    return child;
+}
+
+/*
+ * Reads a single directory, subdirectories are handed to enqueue. Returns false if the directory cannot be read.
+ */
+template <typename Enqueue>
+bool readDirectory(const std::filesystem::path& root,
+                   const std::string&           relative,
+                   ScanResult&                  result,
+                   Enqueue&&                    enqueue)
+{
+    Directory directory{relative};
+#if !defined(_WIN32)
+    const auto absolute = relative.empty() ? root : root / relative;
+    DIR*       handle = ::opendir(absolute.c_str());
+    if (handle == nullptr) { return false; }
+
+    while (const dirent* entry = ::readdir(handle))
+    {
+        const std::string_view name{entry->d_name};
+        if (name == "." || name == "..") { continue; }
+
+        bool is_directory = false;
+#ifdef _DIRENT_HAVE_D_TYPE
+        if (entry->d_type != DT_UNKNOWN) { is_directory = entry->d_type == DT_DIR; }
+        else
+#endif
+        {
+            // the file system does not report types, only then an lstat is needed
+            struct stat entry_stat{};
+            is_directory = ::fstatat(::dirfd(handle), entry->d_name, &entry_stat, AT_SYMLINK_NOFOLLOW) == 0 &&
+                           S_ISDIR(entry_stat.st_mode);
+        }
+
+        if (is_directory)
+        {
+            ++directory.subdirectory_count;
+            enqueue(childPath(relative, name));
+        }
+        else
+        {
+            ++directory.file_count;
+            result.files.push_back(childPath(relative, name));
+        }
+    }
+    ::closedir(handle);
+#else
+    // the Windows directory enumeration reports the attributes, directory_entry caches them
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(relative.empty() ? root : root / relative, ec), end;
+         !ec && it != end;
+         it.increment(ec))
+    {
+        const auto name = it->path().filename().generic_string();
+        if (it->is_directory(ec) && !it->is_symlink(ec))
+        {
+            ++directory.subdirectory_count;
+            enqueue(childPath(relative, name));
+        }
+        else
+        {
+            ++directory.file_count;
+            result.files.push_back(childPath(relative, name));
+        }
+    }
+    if (ec) { return false; }
+#endif
+    result.directories.push_back(std::move(directory));
+    return true;
+}
+
+std::vector<std::string_view> filterFiles(const std::vector<std::string>& files, auto&& predicate)
+{
+    std::vector<std::string_view> result;
+    for (const auto& file : files)
+    {
+        if (predicate(std::string_view{file})) { result.emplace_back(file); }
+    }
+    return result;
+}
+} // namespace
+
+pg::foundation::DirectorySnapshot::DirectorySnapshot(std::filesystem::path      root,
+                                                     std::vector<Directory>&&   directories,
+                                                     std::vector<std::string>&& files)
+  : _root(std::move(root))
+  , _directories(std::move(directories))
+  , _files(std::move(files))
+{
+}
+
+const pg::foundation::DirectorySnapshot::Directory* pg::foundation::DirectorySnapshot::findDirectory(
+    std::string_view relative_path) const
+{
+    auto it = std::ranges::lower_bound(_directories, relative_path, {}, &Directory::path);
+    return (it != _directories.end() && it->path == relative_path) ? &*it : nullptr;
+}
+
+bool pg::foundation::DirectorySnapshot::isLeafDirectory(std::string_view relative_path) const
+{
+    const auto* directory = findDirectory(relative_path);
+    if (directory == nullptr) { throw std::out_of_range(std::format("{} is no scanned directory", relative_path)); }
+    return directory->isLeaf();
+}
+
+std::vector<std::string_view> pg::foundation::DirectorySnapshot::leafDirectories() const
+{
+    std::vector<std::string_view> result;
+    for (const auto& directory : _directories)
+    {
+        if (directory.isLeaf()) { result.emplace_back(directory.path); }
+    }
+    return result;
+}
+
+std::vector<std::string_view> pg::foundation::DirectorySnapshot::filesWithExtension(std::string_view extension,
+                                                                                    bool caseSensitive) const
+{
+    return filterFiles(_files, [extension, caseSensitive](std::string_view file) {
+        const auto name = file.substr(file.rfind('/') + 1);
+        const auto dot = name.rfind('.');
+        // like std::filesystem::path::extension, a leading dot starts a name and no extension
+        if (dot == std::string_view::npos || dot == 0) { return extension.empty(); }
+        const auto file_extension = name.substr(dot);
+        return caseSensitive ? file_extension == extension : strings::equalsIgnoreCase(file_extension, extension);
+    });
+}
+
+std::vector<std::string_view> pg::foundation::DirectorySnapshot::glob(std::string_view pattern,
+                                                                      bool             caseSensitive) const
+{
+    const strings::WildcardPattern wildcard(pattern, caseSensitive);
+    return filterFiles(_files, [&wildcard](std::string_view file) { return wildcard.matches(file); });
+}
+
+std::vector<std::string_view> pg::foundation::DirectorySnapshot::glob(const strings::PatternSet& patterns) const
+{
+    return filterFiles(_files, [&patterns](std::string_view file) { return patterns.matchesAny(file); });
+}
+
+pg::foundation::DirectorySnapshot pg::foundation::DirectoryScanner::scan(const std::filesystem::path& root) const
+{
+    const size_t thread_count =
+        _config.max_threads != 0 ? _config.max_threads : std::max(1u, std::thread::hardware_concurrency());
+
+    // directories waiting to be read, busy counts the ones being read so workers know when the scan is complete
+    std::mutex              mutex;
+    std::condition_variable wake;
+    std::deque<std::string> queue{std::string{}};
+    size_t                  busy = 0;
+    bool                    root_readable = true;
+
+    auto worker = [&](ScanResult& result) {
+        std::vector<std::string> discovered;
+        auto collect = [&discovered](std::string&& directory) { discovered.push_back(std::move(directory)); };
+
+        std::unique_lock lk(mutex);
+        while (true)
+        {
+            wake.wait(lk, [&] { return !queue.empty() || busy == 0; });
+            if (queue.empty()) { break; }
+
+            auto directory = std::move(queue.front());
+            queue.pop_front();
+            ++busy;
+            lk.unlock();
+
+            const bool readable = readDirectory(root, directory, result, collect);
+
+            lk.lock();
+            --busy;
+            if (!readable && directory.empty()) { root_readable = false; }
+            std::ranges::move(discovered, std::back_inserter(queue));
+            discovered.clear();
+            wake.notify_all();
+        }
+    };
+
+    std::vector<ScanResult> results(thread_count);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t i = 1; i < thread_count; ++i)
+        {
+            threads.emplace_back(worker, std::ref(results[i]));
+        }
+        worker(results[0]);
+    }
+    if (!root_readable) { throw std::runtime_error(std::format("Cannot read directory {}", root.string())); }
+
+    std::vector<Directory>   directories;
+    std::vector<std::string> files;
+    for (auto& result : results)
+    {
+        std::ranges::move(result.directories, std::back_inserter(directories));
+        std::ranges::move(result.files, std::back_inserter(files));
+    }
+    std::ranges::sort(directories, {}, &Directory::path);
+    std::ranges::sort(files);
+    return {root, std::move(directories), std::move(files)};
+}
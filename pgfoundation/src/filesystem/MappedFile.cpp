@@ -0,0 +1,154 @@
+#include <pgf/filesystem/MappedFile.hpp>
+#include <cstdint>
+#include <format>
+#include <stdexcept>
+#include <system_error>
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct pg::foundation::MappedFile::Mapping
+{
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+
+    explicit Mapping(const std::filesystem::path& path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+        if (file == INVALID_HANDLE_VALUE) { fail(path, GetLastError(), std::system_category()); }
+
+        LARGE_INTEGER file_size{};
+        GetFileSizeEx(file, &file_size);
+        size = static_cast<size_t>(file_size.QuadPart);
+        if (size != 0)
+        {
+            HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr)
+            {
+                address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+            }
+            if (address == nullptr)
+            {
+                auto error = GetLastError();
+                CloseHandle(file);
+                fail(path, error, std::system_category());
+            }
+        }
+        CloseHandle(file);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) { fail(path, errno, std::generic_category()); }
+
+        struct stat file_stat{};
+        if (::fstat(fd, &file_stat) != 0)
+        {
+            auto error = errno;
+            ::close(fd);
+            fail(path, error, std::generic_category());
+        }
+        size = static_cast<size_t>(file_stat.st_size);
+        // mmap refuses empty ranges, an empty file is simply represented by an empty view
+        if (size != 0)
+        {
+            address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (address == MAP_FAILED)
+            {
+                auto error = errno;
+                address = nullptr;
+                ::close(fd);
+                fail(path, error, std::generic_category());
+            }
+        }
+        // the mapping keeps its own reference to the file
+        ::close(fd);
+#endif
+    }
+
+    ~Mapping()
+    {
+        if (address == nullptr) { return; }
+#ifdef _WIN32
+        UnmapViewOfFile(address);
+#else
+        ::munmap(address, size);
+#endif
+    }
+
+    [[noreturn]] static void fail(const std::filesystem::path& path, int error, const std::error_category& category)
+    {
+        throw std::system_error(error, category, std::format("Cannot map file {}", path.string()));
+    }
+
+    void*  address = nullptr;
+    size_t size = 0;
+};
+
+pg::foundation::MappedFile::MappedFile(const std::filesystem::path& path)
+  : _mapping(std::make_shared<const Mapping>(path))
+  , _bytes(static_cast<const std::byte*>(_mapping->address), _mapping->size)
+{
+}
+
+pg::foundation::MappedFile pg::foundation::MappedFile::slice(size_t offset, size_t length) const
+{
+    if (offset > _bytes.size() || length > _bytes.size() - offset)
+    {
+        throw std::out_of_range(std::format("Slice [{}, {}) exceeds mapped size {}", offset, offset + length, size()));
+    }
+    MappedFile result;
+    result._mapping = _mapping;
+    result._bytes = _bytes.subspan(offset, length);
+    return result;
+}
+
+void pg::foundation::MappedFile::advise([[maybe_unused]] Access access) const
+{
+    if (_bytes.empty()) { return; }
+#ifdef _WIN32
+    if (access == Access::WillNeed)
+    {
+        WIN32_MEMORY_RANGE_ENTRY range{const_cast<std::byte*>(_bytes.data()), _bytes.size()};
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#else
+    int advice = MADV_NORMAL;
+    switch (access)
+    {
+    case Access::Normal:
+        advice = MADV_NORMAL;
+        break;
+    case Access::Sequential:
+        advice = MADV_SEQUENTIAL;
+        break;
+    case Access::Random:
+        advice = MADV_RANDOM;
+        break;
+    case Access::WillNeed:
+        advice = MADV_WILLNEED;
+        break;
+    }
+    // madvise needs a page aligned start address, slices may start anywhere
+    static const auto page_size = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+    auto              begin = reinterpret_cast<uintptr_t>(_bytes.data());
+    auto              aligned_begin = begin & ~(page_size - 1);
+    ::madvise(reinterpret_cast<void*>(aligned_begin), _bytes.size() + (begin - aligned_begin), advice);
+#endif
+}
@@ -0,0 +1,167 @@
+#include <pgf/serialization/ConfigCache.hpp>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <format>
+#include <optional>
+#include <random>
+#include <span>
+#include <spanstream>
+#include <string>
+#include <pgf/filesystem/MappedFile.hpp>
+#include <pgf/serialization/Yaml2Json.hpp>
+
+static_assert(std::endian::native == std::endian::little, "config snapshots are stored little endian");
+
+namespace {
+constexpr auto sidecar_extension = ".pgfconf";
+
+// identification of a source file, the content hash is only computed when needed
+struct Source
+{
+    std::string path; //< absolute, generic format
+    int64_t     mtime;
+    uint64_t    size;
+};
+
+Source describe(const std::filesystem::path& yaml)
+{
+    return {std::filesystem::absolute(yaml).lexically_normal().generic_string(),
+            static_cast<int64_t>(std::filesystem::last_write_time(yaml).time_since_epoch().count()),
+            static_cast<uint64_t>(std::filesystem::file_size(yaml))};
+}
+
+// FNV-1a, persisted so it has to be stable across platforms and runs
+uint64_t fnv1a(std::string_view bytes)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (auto c : bytes)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// the payload of a sidecar if it belongs to source, std::nullopt if it is missing, stale or corrupt
+std::optional<nlohmann::json> readSidecar(const std::filesystem::path& sidecar,
+                                          const Source&                source,
+                                          const std::filesystem::path& yaml,
+                                          bool                         verify_hash)
+{
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(sidecar, error)) { return std::nullopt; }
+
+    try
+    {
+        pg::foundation::MappedFile           file(sidecar);
+        pg::foundation::config_cache::Header header{};
+        if (file.size() < sizeof(header)) { return std::nullopt; }
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        if (header.magic != pg::foundation::config_cache::magic ||
+            header.version != pg::foundation::config_cache::version || header.source_mtime != source.mtime ||
+            header.source_size != source.size || header.path_length != source.path.size() ||
+            sizeof(header) + header.path_length > file.size() ||
+            file.view().substr(sizeof(header), header.path_length) != source.path)
+        {
+            return std::nullopt;
+        }
+        if (verify_hash && header.source_hash != fnv1a(pg::foundation::MappedFile(yaml).view()))
+        {
+            return std::nullopt;
+        }
+
+        const auto payload = file.bytes().subspan(sizeof(header) + header.path_length);
+        const auto* first = reinterpret_cast<const uint8_t*>(payload.data());
+        const auto* last = first + payload.size();
+        switch (header.format)
+        {
+        case pg::foundation::config_cache::Format::Cbor:
+            return nlohmann::json::from_cbor(first, last);
+        case pg::foundation::config_cache::Format::MessagePack:
+            return nlohmann::json::from_msgpack(first, last);
+        }
+    }
+    catch (const std::exception&)
+    {
+        // unreadable or corrupt snapshots are converted again
+    }
+    return std::nullopt;
+}
+
+void writeSidecar(const std::filesystem::path&         sidecar,
+                  const Source&                        source,
+                  uint64_t                             hash,
+                  pg::foundation::config_cache::Format format,
+                  const nlohmann::json&                json)
+{
+    pg::foundation::config_cache::Header header{pg::foundation::config_cache::magic,
+                                                pg::foundation::config_cache::version,
+                                                format,
+                                                source.mtime,
+                                                source.size,
+                                                hash,
+                                                source.path.size()};
+    const auto payload = format == pg::foundation::config_cache::Format::Cbor ? nlohmann::json::to_cbor(json)
+                                                                              : nlohmann::json::to_msgpack(json);
+
+    // write a temporary file and rename it, so concurrent loads never see a partial snapshot
+    std::error_code error;
+    std::filesystem::create_directories(sidecar.parent_path(), error);
+    auto temporary = sidecar;
+    temporary += std::format(".{:08x}.tmp", std::random_device{}());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(source.path.data(), static_cast<std::streamsize>(source.path.size()));
+        out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        if (!out) { error = std::make_error_code(std::errc::io_error); }
+    }
+    if (!error) { std::filesystem::rename(temporary, sidecar, error); }
+    if (error) { std::filesystem::remove(temporary, error); }
+}
+} // namespace
+
+pg::foundation::ConfigCache::ConfigCache(Config&& config)
+  : _config(std::move(config))
+{
+}
+
+std::filesystem::path pg::foundation::ConfigCache::sidecarPath(const std::filesystem::path& yaml) const
+{
+    if (_config.cache_directory.empty())
+    {
+        auto sidecar = yaml;
+        return sidecar += sidecar_extension;
+    }
+    // flatten the absolute source path into a unique file name within the cache directory
+    const auto source = std::filesystem::absolute(yaml).lexically_normal().generic_string();
+    return _config.cache_directory /
+           std::format("{}-{:016x}{}", yaml.filename().string(), fnv1a(source), sidecar_extension);
+}
+
+bool pg::foundation::ConfigCache::invalidate(const std::filesystem::path& yaml) const
+{
+    std::error_code error;
+    return std::filesystem::remove(sidecarPath(yaml), error);
+}
+
+nlohmann::json pg::foundation::ConfigCache::load(const std::filesystem::path& yaml)
+{
+    const auto source = describe(yaml);
+    const auto sidecar = sidecarPath(yaml);
+    if (auto json = readSidecar(sidecar, source, yaml, _config.verify_hash))
+    {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return std::move(*json);
+    }
+    _misses.fetch_add(1, std::memory_order_relaxed);
+
+    // hash exactly the bytes that are converted, the stream reads the mapping in place
+    MappedFile       content(yaml);
+    std::ispanstream stream(std::span<const char>{content.view()});
+    auto             json = yaml2json(stream);
+    writeSidecar(sidecar, source, fnv1a(content.view()), _config.format, json);
+    return json;
+}
@@ -0,0 +1,428 @@
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <yaml-cpp/eventhandler.h>
+#include <pgf/serialization/Yaml2Json.hpp>
+
+namespace {
+constexpr auto non_scalar_key = "Only scalar keys can be transformed to JSON";
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// integer in the given base, falling back from int64 to uint64 for large positive values
+template <int Base>
+std::optional<nlohmann::json> parseInteger(std::string_view digits, bool negative)
+{
+    const auto* first = digits.data();
+    const auto* last = first + digits.size();
+    if (first == last) { return std::nullopt; }
+    if (negative)
+    {
+        // parse the magnitude, INT64_MIN has no positive int64 counterpart
+        uint64_t magnitude = 0;
+        auto [end, error] = std::from_chars(first, last, magnitude, Base);
+        if (error != std::errc{} || end != last) { return std::nullopt; }
+        if (magnitude > uint64_t{INT64_MAX} + 1) { return std::nullopt; }
+        return static_cast<int64_t>(0 - magnitude);
+    }
+    uint64_t value = 0;
+    auto [end, error] = std::from_chars(first, last, value, Base);
+    if (error != std::errc{} || end != last) { return std::nullopt; }
+    if (value <= uint64_t{INT64_MAX}) { return static_cast<int64_t>(value); }
+    return value;
+}
+
+/*
+ * [-+]? ( \. [0-9]+ | [0-9]+ ( \. [0-9]* )? ) ( [eE] [-+]? [0-9]+ )?
+ * from_chars accepts a superset (inf, nan, no leading plus), so the shape is checked first.
+ */
+std::optional<double> parseFloat(std::string_view value)
+{
+    size_t i = (value.front() == '-' || value.front() == '+') ? 1 : 0;
+    size_t mantissa_digits = 0;
+    for (; i < value.size() && isDigit(value[i]); ++i, ++mantissa_digits) {}
+    if (i < value.size() && value[i] == '.')
+    {
+        for (++i; i < value.size() && isDigit(value[i]); ++i, ++mantissa_digits) {}
+    }
+    if (mantissa_digits == 0) { return std::nullopt; }
+    if (i < value.size() && (value[i] == 'e' || value[i] == 'E'))
+    {
+        ++i;
+        if (i < value.size() && (value[i] == '-' || value[i] == '+')) { ++i; }
+        const auto exponent_start = i;
+        for (; i < value.size() && isDigit(value[i]); ++i) {}
+        if (i == exponent_start) { return std::nullopt; }
+    }
+    if (i != value.size()) { return std::nullopt; }
+
+    const auto* first = value.data() + (value.front() == '+' ? 1 : 0);
+    double      result = 0;
+    auto [end, error] = std::from_chars(first, value.data() + value.size(), result);
+    // out of range values are rejected by from_chars, YAML wants them as infinity
+    if (error == std::errc::result_out_of_range)
+    {
+        return value.front() == '-' ? -std::numeric_limits<double>::infinity()
+                                    : std::numeric_limits<double>::infinity();
+    }
+    if (error != std::errc{}) { return std::nullopt; }
+    return result;
+}
+
+/*
+ * Builds a json value from parser events. Containers under construction are kept on a stack, their elements are
+ * added in place (elements of arrays are never moved while their array is open and objects are node based).
+ */
+class JsonBuilder : public YAML::EventHandler
+{
+public:
+    void OnDocumentStart(const YAML::Mark&) override {}
+
+    void OnDocumentEnd() override {}
+
+    void OnNull(const YAML::Mark&, YAML::anchor_t anchor) override
+    {
+        if (anchor != 0) { _scalars[anchor] = "null"; }
+        if (expectsKey())
+        {
+            _stack.back().key = "null";
+            return;
+        }
+        add(nullptr, anchor);
+    }
+
+    void OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor) override
+    {
+        if (expectsKey())
+        {
+            auto scalar = _scalars.find(anchor);
+            if (scalar == _scalars.end()) { throw std::invalid_argument(non_scalar_key); }
+            _stack.back().key = scalar->second;
+            return;
+        }
+        auto it = _anchors.find(anchor);
+        if (it == _anchors.end()) { throw YAML::ParserException(mark, "unknown alias"); }
+        add(nlohmann::json(it->second), 0);
+    }
+
+    void OnScalar(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, const std::string& value) override
+    {
+        if (anchor != 0) { _scalars[anchor] = value; }
+        if (expectsKey())
+        {
+            _stack.back().key = value;
+            return;
+        }
+        add(pg::foundation::internal::parse_scalar(value, tag), anchor);
+    }
+
+    void OnSequenceStart(const YAML::Mark&,
+                         const std::string&,
+                         YAML::anchor_t anchor,
+                         YAML::EmitterStyle::value) override
+    {
+        open(nlohmann::json::array(), anchor);
+    }
+
+    void OnSequenceEnd() override { close(); }
+
+    void OnMapStart(const YAML::Mark&, const std::string&, YAML::anchor_t anchor, YAML::EmitterStyle::value) override
+    {
+        open(nlohmann::json::object(), anchor);
+    }
+
+    void OnMapEnd() override { close(); }
+
+    nlohmann::json take() { return std::move(_root); }
+
+private:
+    struct Frame
+    {
+        nlohmann::json*            value;
+        YAML::anchor_t             anchor;
+        std::optional<std::string> key; //< of the next value in an object
+    };
+
+    bool expectsKey() const { return !_stack.empty() && _stack.back().value->is_object() && !_stack.back().key; }
+
+    nlohmann::json& add(nlohmann::json&& value, YAML::anchor_t anchor)
+    {
+        if (expectsKey()) { throw std::invalid_argument(non_scalar_key); }
+        if (anchor != 0) { _anchors[anchor] = value; }
+
+        if (_stack.empty()) { return _root = std::move(value); }
+        auto& parent = _stack.back();
+        if (parent.value->is_array())
+        {
+            parent.value->push_back(std::move(value));
+            return parent.value->back();
+        }
+        auto& slot = (*parent.value)[*parent.key];
+        slot = std::move(value);
+        parent.key.reset();
+        return slot;
+    }
+
+    void open(nlohmann::json&& container, YAML::anchor_t anchor)
+    {
+        auto& value = add(std::move(container), 0);
+        _stack.push_back({&value, anchor, std::nullopt});
+    }
+
+    void close()
+    {
+        if (_stack.back().anchor != 0) { _anchors[_stack.back().anchor] = *_stack.back().value; }
+        _stack.pop_back();
+    }
+
+    nlohmann::json                                     _root;
+    std::vector<Frame>                                 _stack;
+    std::unordered_map<YAML::anchor_t, nlohmann::json> _anchors;
+    std::unordered_map<YAML::anchor_t, std::string>    _scalars; //< text of anchored scalars, for aliases used as keys
+};
+
+/*
+ * Writes compact json from parser events. Output is collected in a buffer that is flushed to the stream once it is
+ * large enough, unless an anchored value is being written: its text is kept to be repeated for each alias.
+ */
+class JsonWriter : public YAML::EventHandler
+{
+public:
+    explicit JsonWriter(std::ostream& out)
+      : _out(out)
+    {
+    }
+
+    void OnDocumentStart(const YAML::Mark&) override {}
+
+    void OnDocumentEnd() override { flush(); }
+
+    void OnNull(const YAML::Mark&, YAML::anchor_t anchor) override
+    {
+        if (anchor != 0) { _scalars[anchor] = "null"; }
+        if (expectsKey())
+        {
+            writeKey("null");
+            return;
+        }
+        writeValue("null", anchor);
+    }
+
+    void OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor) override
+    {
+        if (expectsKey())
+        {
+            auto scalar = _scalars.find(anchor);
+            if (scalar == _scalars.end()) { throw std::invalid_argument(non_scalar_key); }
+            writeKey(scalar->second);
+            return;
+        }
+        auto it = _anchors.find(anchor);
+        if (it == _anchors.end()) { throw YAML::ParserException(mark, "unknown alias"); }
+        writeValue(it->second, 0);
+    }
+
+    void OnScalar(const YAML::Mark&, const std::string& tag, YAML::anchor_t anchor, const std::string& value) override
+    {
+        if (anchor != 0) { _scalars[anchor] = value; }
+        if (expectsKey())
+        {
+            writeKey(value);
+            return;
+        }
+        writeValue(pg::foundation::internal::parse_scalar(value, tag).dump(), anchor);
+    }
+
+    void OnSequenceStart(const YAML::Mark&,
+                         const std::string&,
+                         YAML::anchor_t anchor,
+                         YAML::EmitterStyle::value) override
+    {
+        open('[', anchor, false);
+    }
+
+    void OnSequenceEnd() override { close(']'); }
+
+    void OnMapStart(const YAML::Mark&, const std::string&, YAML::anchor_t anchor, YAML::EmitterStyle::value) override
+    {
+        open('{', anchor, true);
+    }
+
+    void OnMapEnd() override { close('}'); }
+
+private:
+    static constexpr size_t flush_size = 64 * 1024;
+
+    struct Frame
+    {
+        YAML::anchor_t anchor;
+        size_t         start; //< of the container text in the buffer, only kept for anchored containers
+        bool           is_object;
+        bool           expects_key;
+        bool           empty = true;
+    };
+
+    bool expectsKey() const { return !_stack.empty() && _stack.back().expects_key; }
+
+    // comma before all but the first element or key
+    void separate()
+    {
+        if (_stack.empty()) { return; }
+        auto& frame = _stack.back();
+        if (!frame.empty && (!frame.is_object || frame.expects_key)) { _buffer += ','; }
+        frame.empty = false;
+    }
+
+    void afterValue()
+    {
+        if (!_stack.empty() && _stack.back().is_object) { _stack.back().expects_key = true; }
+        if (_recording == 0 && _buffer.size() >= flush_size) { flush(); }
+    }
+
+    void writeKey(std::string_view key)
+    {
+        separate();
+        _buffer += nlohmann::json(key).dump();
+        _buffer += ':';
+        _stack.back().expects_key = false;
+    }
+
+    void writeValue(const std::string& text, YAML::anchor_t anchor)
+    {
+        if (expectsKey()) { throw std::invalid_argument(non_scalar_key); }
+        separate();
+        if (anchor != 0) { _anchors[anchor] = text; }
+        _buffer += text;
+        afterValue();
+    }
+
+    void open(char bracket, YAML::anchor_t anchor, bool is_object)
+    {
+        if (expectsKey()) { throw std::invalid_argument(non_scalar_key); }
+        separate();
+        if (anchor != 0) { ++_recording; }
+        _stack.push_back({anchor, _buffer.size(), is_object, is_object});
+        _buffer += bracket;
+    }
+
+    void close(char bracket)
+    {
+        _buffer += bracket;
+        const auto frame = _stack.back();
+        _stack.pop_back();
+        if (frame.anchor != 0)
+        {
+            _anchors[frame.anchor] = _buffer.substr(frame.start);
+            --_recording;
+        }
+        afterValue();
+    }
+
+    void flush()
+    {
+        _out.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _buffer.clear();
+    }
+
+    std::ostream&                                   _out;
+    std::string                                     _buffer;
+    std::vector<Frame>                              _stack;
+    std::unordered_map<YAML::anchor_t, std::string> _anchors;       //< json text of anchored values
+    std::unordered_map<YAML::anchor_t, std::string> _scalars;       //< text of anchored scalars, for keys
+    size_t                                          _recording = 0; //< open anchored containers, no flushing meanwhile
+};
+} // namespace
+
+nlohmann::json pg::foundation::internal::parse_scalar(std::string_view value, std::string_view tag)
+{
+    // quoted scalars and explicit strings are never resolved
+    if (tag == "!" || tag == "tag:yaml.org,2002:str") { return std::string{value}; }
+    if (value.empty()) { return nullptr; }
+
+    // the first character decides which rules can apply at all, so every scalar is scanned at most twice
+    switch (value.front())
+    {
+    case '~':
+        if (value.size() == 1) { return nullptr; }
+        break;
+    case 'n':
+    case 'N':
+        if (value == "null" || value == "Null" || value == "NULL") { return nullptr; }
+        break;
+    case 't':
+    case 'T':
+        if (value == "true" || value == "True" || value == "TRUE") { return true; }
+        break;
+    case 'f':
+    case 'F':
+        if (value == "false" || value == "False" || value == "FALSE") { return false; }
+        break;
+    case '.':
+        if (value == ".inf" || value == ".Inf" || value == ".INF") { return std::numeric_limits<double>::infinity(); }
+        if (value == ".nan" || value == ".NaN" || value == ".NAN") { return std::numeric_limits<double>::quiet_NaN(); }
+        if (auto d = parseFloat(value)) { return *d; }
+        break;
+    case '-':
+    case '+':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9': {
+        const bool negative = value.front() == '-';
+        const auto unsigned_value = value.substr(value.front() == '-' || value.front() == '+' ? 1 : 0);
+        if (unsigned_value == ".inf" || unsigned_value == ".Inf" || unsigned_value == ".INF")
+        {
+            return negative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+        }
+        // octal and hexadecimal take no sign
+        if (value.starts_with("0o"))
+        {
+            if (auto i = parseInteger<8>(value.substr(2), false)) { return *i; }
+            break;
+        }
+        if (value.starts_with("0x"))
+        {
+            if (auto i = parseInteger<16>(value.substr(2), false)) { return *i; }
+            break;
+        }
+        if (std::ranges::all_of(unsigned_value, isDigit))
+        {
+            if (auto i = parseInteger<10>(unsigned_value, negative)) { return *i; }
+        }
+        if (auto d = parseFloat(value)) { return *d; }
+        break;
+    }
+    default:
+        break;
+    }
+    return std::string{value};
+}
+
+nlohmann::json pg::foundation::yaml2json(std::istream& yaml)
+{
+    YAML::Parser parser(yaml);
+    JsonBuilder  builder;
+    parser.HandleNextDocument(builder);
+    return builder.take();
+}
+
+void pg::foundation::yaml2json(std::istream& yaml, std::ostream& json)
+{
+    YAML::Parser parser(yaml);
+    JsonWriter   writer(json);
+    if (!parser.HandleNextDocument(writer)) { json << "null"; }
+}
@@ -0,0 +1,85 @@
+#include <pgf/streaming/AudioStream.hpp>
+#include <stdexcept>
+
+pg::foundation::AudioStream::AudioStream(Decoder decoder, Sink sink, Config&& cfg)
+  : _config(cfg)
+  , _state(std::make_shared<State>(std::move(decoder), std::move(sink), StreamBuffer::Config{cfg.buffer}))
+{
+}
+
+pg::foundation::AudioStream::~AudioStream()
+{
+    stop();
+}
+
+void pg::foundation::AudioStream::start(TaskEngine& engine)
+{
+    if (_started) { throw std::logic_error("AudioStream is already started"); }
+    _started = true;
+    _decode_thread = std::jthread([state = _state] { state->decode(); });
+    // the task only holds the state, it ends on its own once the stream finished or was stopped
+    engine.addTask([state = _state] { return state->refill(); }, true, {}, _config.refill_interval);
+}
+
+void pg::foundation::AudioStream::stop()
+{
+    _state->stopped.store(true, std::memory_order_release);
+    // wake the decode thread if it waits for a free chunk
+    _state->released.fetch_add(1, std::memory_order_release);
+    _state->released.notify_one();
+    if (_decode_thread.joinable()) { _decode_thread.join(); }
+    // a refill that already passed its stopped check finishes before we return
+    const std::lock_guard lk(_state->refill_mutex);
+}
+
+void pg::foundation::AudioStream::State::decode()
+{
+    // fill every free chunk, then sleep until the refill task returns one
+    while (!stopped.load(std::memory_order_acquire))
+    {
+        // read before acquiring, so a release in between makes the wait return at once
+        const auto seen = released.load(std::memory_order_acquire);
+        auto*      chunk = buffer.acquire();
+        if (chunk == nullptr)
+        {
+            released.wait(seen, std::memory_order_acquire);
+            continue;
+        }
+        chunk->size = decoder(chunk->data);
+        chunk->end_of_stream = chunk->size == 0;
+        bytes_decoded.fetch_add(chunk->size, std::memory_order_relaxed);
+        buffer.commit(chunk);
+        if (chunk->end_of_stream) { return; }
+    }
+}
+
+bool pg::foundation::AudioStream::State::refill()
+{
+    const std::lock_guard lk(refill_mutex);
+    if (stopped.load(std::memory_order_acquire)) { return true; }
+    while (true)
+    {
+        auto* chunk = pending != nullptr ? pending : buffer.next();
+        if (chunk == nullptr)
+        {
+            underruns.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (chunk->end_of_stream)
+        {
+            buffer.release(chunk);
+            finished.store(true, std::memory_order_release);
+            return true;
+        }
+        if (!sink(chunk->bytes()))
+        {
+            pending = chunk;
+            return false;
+        }
+        pending = nullptr;
+        bytes_delivered.fetch_add(chunk->size, std::memory_order_relaxed);
+        buffer.release(chunk);
+        released.fetch_add(1, std::memory_order_release);
+        released.notify_one();
+    }
+}
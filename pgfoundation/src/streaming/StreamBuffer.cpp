@@ -0,0 +1,45 @@
+#include <pgf/streaming/StreamBuffer.hpp>
+#include <stdexcept>
+
+pg::foundation::StreamBuffer::StreamBuffer(Config&& cfg)
+  : _config(cfg)
+  , _free(cfg.chunk_count)
+  , _filled(cfg.chunk_count)
+{
+    if (_config.chunk_size == 0 || _config.chunk_count == 0)
+    {
+        throw std::invalid_argument("StreamBuffer needs a non-zero chunk size and count");
+    }
+    _memory = std::make_unique<std::byte[]>(_config.chunk_size * _config.chunk_count);
+    _chunks.resize(_config.chunk_count);
+    for (size_t i = 0; i < _chunks.size(); ++i)
+    {
+        _chunks[i].data = {_memory.get() + i * _config.chunk_size, _config.chunk_size};
+        _free.tryPush(&_chunks[i]);
+    }
+}
+
+pg::foundation::StreamChunk* pg::foundation::StreamBuffer::acquire()
+{
+    auto chunk = _free.tryPop();
+    if (!chunk) { return nullptr; }
+    (*chunk)->size = 0;
+    (*chunk)->end_of_stream = false;
+    return *chunk;
+}
+
+void pg::foundation::StreamBuffer::commit(StreamChunk* chunk)
+{
+    // both rings hold every chunk, so pushing a chunk that came from the pool cannot fail
+    _filled.tryPush(chunk);
+}
+
+pg::foundation::StreamChunk* pg::foundation::StreamBuffer::next()
+{
+    return _filled.tryPop().value_or(nullptr);
+}
+
+void pg::foundation::StreamBuffer::release(StreamChunk* chunk)
+{
+    _free.tryPush(chunk);
+}
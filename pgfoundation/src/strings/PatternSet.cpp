@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <bit>
+#include <pgf/strings/PatternSet.hpp>
+
+/*
+ * Every pattern is laid out as a run of states: a start state followed by one state per element (character, '?' or a
+ * collapsed run of '*'). State i is active if the input consumed so far matches the pattern up to element i. Consuming
+ * a character shifts all active states by one, masked by the states that accept the character, and keeps stars active.
+ * Stars may also match nothing: a star becomes active as soon as the state before it is.
+ * Start states never accept a character, which also keeps the shift from carrying over into the next pattern.
+ */
+
+namespace {
+unsigned char foldAscii(unsigned char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+}
+} // namespace
+
+pg::foundation::strings::PatternSet::PatternSet(std::initializer_list<std::string_view> patterns, bool caseSensitive)
+  : _case_sensitive(caseSensitive)
+{
+    for (auto pattern : patterns)
+    {
+        add(pattern);
+    }
+}
+
+void pg::foundation::strings::PatternSet::setBit(States& bits, size_t bit)
+{
+    bits[bit / word_bits] |= Word{1} << (bit % word_bits);
+}
+
+size_t pg::foundation::strings::PatternSet::add(std::string_view pattern)
+{
+    // worst case every character is an element
+    const size_t words = (_bit_count + pattern.size() + 1 + word_bits - 1) / word_bits;
+    _char_masks.resize(words, {});
+    _start.resize(words, 0);
+    _stars.resize(words, 0);
+    _accept.resize(words, 0);
+
+    setBit(_start, _bit_count++);
+    bool previous_star = false;
+    for (char c : pattern)
+    {
+        if (c == '*')
+        {
+            if (previous_star) { continue; }
+            previous_star = true;
+            setBit(_stars, _bit_count);
+            for (auto& word : _char_masks[_bit_count / word_bits])
+            {
+                word |= Word{1} << (_bit_count % word_bits);
+            }
+        }
+        else if (c == '?')
+        {
+            previous_star = false;
+            for (auto& word : _char_masks[_bit_count / word_bits])
+            {
+                word |= Word{1} << (_bit_count % word_bits);
+            }
+        }
+        else
+        {
+            previous_star = false;
+            const auto character = static_cast<unsigned char>(c);
+            const auto bit = Word{1} << (_bit_count % word_bits);
+            auto&      masks = _char_masks[_bit_count / word_bits];
+            if (_case_sensitive) { masks[character] |= bit; }
+            else
+            {
+                // the input is folded while matching
+                masks[foldAscii(character)] |= bit;
+            }
+        }
+        ++_bit_count;
+    }
+    const auto accept_bit = _bit_count - 1;
+    setBit(_accept, accept_bit);
+    _accept_bits.push_back(accept_bit);
+    return _accept_bits.size() - 1;
+}
+
+pg::foundation::strings::PatternSet::States pg::foundation::strings::PatternSet::run(std::string_view s) const
+{
+    const size_t words = _start.size();
+    States       active(words);
+    States       next(words);
+
+    // stars directly after a start state are active before anything was consumed
+    for (size_t w = 0; w < words; ++w)
+    {
+        const Word carry = w == 0 ? 0 : _start[w - 1] >> (word_bits - 1);
+        active[w] = _start[w] | (((_start[w] << 1) | carry) & _stars[w]);
+    }
+
+    for (char c : s)
+    {
+        const auto character = _case_sensitive ? static_cast<unsigned char>(c) : foldAscii(c);
+        Word       any = 0;
+        Word       carry = 0;
+        for (size_t w = 0; w < words; ++w)
+        {
+            next[w] = (((active[w] << 1) | carry) & _char_masks[w][character]) | (active[w] & _stars[w]);
+            carry = active[w] >> (word_bits - 1);
+        }
+        carry = 0;
+        for (size_t w = 0; w < words; ++w)
+        {
+            const Word entered = next[w];
+            next[w] |= ((entered << 1) | carry) & _stars[w];
+            carry = entered >> (word_bits - 1);
+            any |= next[w];
+        }
+        active.swap(next);
+        if (any == 0) { break; }
+    }
+
+    for (size_t w = 0; w < words; ++w)
+    {
+        active[w] &= _accept[w];
+    }
+    return active;
+}
+
+std::optional<size_t> pg::foundation::strings::PatternSet::firstMatch(std::string_view s) const
+{
+    const auto accepted = run(s);
+    for (size_t w = 0; w < accepted.size(); ++w)
+    {
+        if (accepted[w] == 0) { continue; }
+        const size_t bit = w * word_bits + static_cast<size_t>(std::countr_zero(accepted[w]));
+        return static_cast<size_t>(std::ranges::lower_bound(_accept_bits, bit) - _accept_bits.begin());
+    }
+    return std::nullopt;
+}
+
+std::vector<size_t> pg::foundation::strings::PatternSet::allMatches(std::string_view s) const
+{
+    const auto          accepted = run(s);
+    std::vector<size_t> result;
+    for (size_t w = 0; w < accepted.size(); ++w)
+    {
+        for (Word word = accepted[w]; word != 0; word &= word - 1)
+        {
+            const size_t bit = w * word_bits + static_cast<size_t>(std::countr_zero(word));
+            result.push_back(static_cast<size_t>(std::ranges::lower_bound(_accept_bits, bit) - _accept_bits.begin()));
+        }
+    }
+    return result;
+}
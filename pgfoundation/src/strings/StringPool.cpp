@@ -0,0 +1,90 @@
+#include <cstring>
+#include <format>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <pgf/strings/StringPool.hpp>
+
+pg::foundation::strings::Symbol pg::foundation::strings::StringPool::intern(std::string_view str)
+{
+    const Key key{str, std::hash<std::string_view>{}(str)};
+    {
+        std::shared_lock lk(_mutex);
+        if (auto it = _index.find(key); it != _index.end()) { return Symbol{*it}; }
+    }
+
+    std::unique_lock lk(_mutex);
+    if (auto it = _index.find(key); it != _index.end()) { return Symbol{*it}; }
+    if (str.size() > std::numeric_limits<uint32_t>::max() || _entries.size() >= Symbol::invalid_id)
+    {
+        throw std::length_error("StringPool capacity exceeded");
+    }
+
+    auto* entry = new (allocate(str.size()))
+        Entry{key.hash, static_cast<SymbolId>(_entries.size()), static_cast<uint32_t>(str.size())};
+    auto* characters = reinterpret_cast<char*>(entry + 1);
+    std::memcpy(characters, str.data(), str.size());
+    characters[str.size()] = '\0';
+
+    _entries.push_back(entry);
+    _index.insert(entry);
+    return Symbol{entry};
+}
+
+pg::foundation::strings::Symbol pg::foundation::strings::StringPool::find(std::string_view str) const
+{
+    const Key        key{str, std::hash<std::string_view>{}(str)};
+    std::shared_lock lk(_mutex);
+    auto             it = _index.find(key);
+    return it == _index.end() ? Symbol{} : Symbol{*it};
+}
+
+pg::foundation::strings::Symbol pg::foundation::strings::StringPool::symbol(SymbolId id) const
+{
+    std::shared_lock lk(_mutex);
+    if (id >= _entries.size()) { throw std::out_of_range(std::format("Unknown symbol id {}", id)); }
+    return Symbol{_entries[id]};
+}
+
+size_t pg::foundation::strings::StringPool::size() const
+{
+    std::shared_lock lk(_mutex);
+    return _entries.size();
+}
+
+size_t pg::foundation::strings::StringPool::memoryUsage() const
+{
+    std::shared_lock lk(_mutex);
+    return _memory;
+}
+
+pg::foundation::strings::StringPool& pg::foundation::strings::StringPool::global()
+{
+    static StringPool pool;
+    return pool;
+}
+
+void* pg::foundation::strings::StringPool::allocate(size_t length)
+{
+    // header, characters and terminator, padded to keep the next header aligned
+    constexpr size_t alignment = alignof(Entry);
+    const size_t     bytes = (sizeof(Entry) + length + 1 + alignment - 1) / alignment * alignment;
+
+    if (bytes > chunk_size / 4)
+    {
+        // large strings get a chunk of their own, the current chunk keeps being filled
+        auto& chunk = _chunks.emplace_back(std::make_unique<std::byte[]>(bytes));
+        _memory += bytes;
+        return chunk.get();
+    }
+    if (_chunk_used + bytes > chunk_size)
+    {
+        _current_chunk = _chunks.emplace_back(std::make_unique<std::byte[]>(chunk_size)).get();
+        _chunk_used = 0;
+        _memory += chunk_size;
+    }
+    auto* storage = _current_chunk + _chunk_used;
+    _chunk_used += bytes;
+    return storage;
+}
@@ -1,57 +1,273 @@
+#include <algorithm>
+#include <bit>
 #include <ranges>
-#include <regex>
 #include <string>
+#include <pgf/strings/Regex.hpp>
 #include <pgf/strings/StringTools.hpp>
 
-static std::string wildcardToRegex(const std::string& s)
+#if defined(__AVX2__)
+#define PGF_STRINGS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PGF_STRINGS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+char foldAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+} // namespace
+
+pg::foundation::strings::WildcardPattern::WildcardPattern(std::string_view pattern, bool caseSensitive)
+  : _case_sensitive(caseSensitive)
 {
-    std::string res = std::regex_replace(s, std::regex("\\."), "\\.");
-    res = std::regex_replace(res, std::regex("\\?"), ".");
+    _pattern.reserve(pattern.size());
+    size_t segment_start = 0;
+    for (char c : pattern)
+    {
+        if (c == '*')
+        {
+            // consecutive stars collapse into one
+            if (!_has_star || _pattern.size() != segment_start)
+            {
+                _segments.push_back({segment_start, _pattern.size() - segment_start});
+            }
+            _has_star = true;
+            segment_start = _pattern.size();
+            continue;
+        }
+        _pattern.push_back(caseSensitive ? c : foldAscii(c));
+    }
+    _segments.push_back({segment_start, _pattern.size() - segment_start});
+    _min_length = _pattern.size();
+}
+
+bool pg::foundation::strings::WildcardPattern::matchesAt(std::string_view s,
+                                                         size_t           position,
+                                                         const Segment&   segment) const
+{
+    for (size_t i = 0; i < segment.length; ++i)
+    {
+        const char p = _pattern[segment.offset + i];
+        const char c = _case_sensitive ? s[position + i] : foldAscii(s[position + i]);
+        if (p != '?' && p != c) { return false; }
+    }
+    return true;
+}
+
+bool pg::foundation::strings::WildcardPattern::matches(std::string_view s) const
+{
+    if (s.size() < _min_length) { return false; }
+    if (!_has_star) { return s.size() == _min_length && matchesAt(s, 0, _segments.front()); }
+
+    // anchored head and tail, the segments in between are placed leftmost-first which never rejects a match
+    const auto& head = _segments.front();
+    const auto& tail = _segments.back();
+    if (!matchesAt(s, 0, head) || !matchesAt(s, s.size() - tail.length, tail)) { return false; }
 
-    return std::regex_replace(res, std::regex("\\*"), ".*");
+    size_t       position = head.length;
+    const size_t end = s.size() - tail.length;
+    for (size_t i = 1; i + 1 < _segments.size(); ++i)
+    {
+        const auto& segment = _segments[i];
+        while (position + segment.length <= end && !matchesAt(s, position, segment))
+        {
+            ++position;
+        }
+        if (position + segment.length > end) { return false; }
+        position += segment.length;
+    }
+    return true;
 }
 
-bool pg::foundation::strings::matches(const std::string& s, const std::string& pattern)
+bool pg::foundation::strings::matches(std::string_view s, std::string_view pattern)
 {
-    std::regex pattern_regex(pattern);
-    return std::regex_search(std::string(s), pattern_regex);
+    return RegexCache::global().get(pattern)->search(s);
 }
 
 bool pg::foundation::strings::matchesWildCard(const std::string& s,
                                               const std::string& wildcardPattern,
                                               bool               caseSensitive /*  =true*/)
 {
-    return std::regex_match(s, std::regex(wildcardToRegex(wildcardPattern)));
+    return WildcardPattern(wildcardPattern, caseSensitive).matches(s);
 }
 
 std::vector<std::string_view> pg::foundation::strings::tokenize(std::string_view       str,
                                                                 const std::string_view delims /*= " "*/)
 {
     std::vector<std::string_view> output;
-    size_t                        first{0};
-
-    while (first < str.size())
+    for (auto token : TokenView(str, delims))
     {
-        const auto second = str.find_first_of(delims, first);
-
-        if (first != second) output.emplace_back(str.substr(first, second - first));
+        output.emplace_back(token);
+    }
+    return output;
+}
 
-        if (second == std::string_view::npos) break;
+pg::foundation::strings::Delimiters::Delimiters(std::string_view delims)
+{
+    for (char c : delims)
+    {
+        if (contains(c)) { continue; }
+        const auto u = static_cast<unsigned char>(c);
+        _table[u / 64] |= uint64_t{1} << (u % 64);
+        if (_count < max_vectorized) { _chars[_count] = c; }
+        ++_count;
+    }
+}
 
-        first = second + 1;
+size_t pg::foundation::strings::Delimiters::findIn(std::string_view str, size_t pos) const
+{
+    const char* data = str.data();
+    const auto  size = str.size();
+#if defined(PGF_STRINGS_SSE2) || defined(PGF_STRINGS_AVX2)
+    if (_count > 0 && _count <= max_vectorized)
+    {
+#if defined(PGF_STRINGS_AVX2)
+        for (; pos + 32 <= size; pos += 32)
+        {
+            const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+            auto       hits = _mm256_setzero_si256();
+            for (size_t i = 0; i < _count; ++i)
+            {
+                hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(_chars[i])));
+            }
+            if (const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits)); mask != 0)
+            {
+                return pos + static_cast<size_t>(std::countr_zero(mask));
+            }
+        }
+#endif
+        for (; pos + 16 <= size; pos += 16)
+        {
+            const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            auto       hits = _mm_setzero_si128();
+            for (size_t i = 0; i < _count; ++i)
+            {
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(_chars[i])));
+            }
+            if (const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hits)); mask != 0)
+            {
+                return pos + static_cast<size_t>(std::countr_zero(mask));
+            }
+        }
+    }
+#endif
+    for (; pos < size; ++pos)
+    {
+        if (contains(data[pos])) { return pos; }
     }
+    return std::string_view::npos;
+}
 
-    return output;
+namespace {
+/*
+ * Flips the ASCII case bit of all characters in [First, Last], copying from in to out (which may alias).
+ * Bytes above 0x7f are negative as signed chars and thus never in range.
+ */
+template <char First, char Last>
+void flipCase(const char* in, char* out, size_t size)
+{
+    constexpr char case_bit = 0x20;
+    size_t         i = 0;
+#if defined(PGF_STRINGS_AVX2)
+    const auto below = _mm256_set1_epi8(First - 1);
+    const auto above = _mm256_set1_epi8(Last + 1);
+    const auto bit = _mm256_set1_epi8(case_bit);
+    for (; i + 32 <= size; i += 32)
+    {
+        const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const auto in_range = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, below), _mm256_cmpgt_epi8(above, chunk));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_xor_si256(chunk, _mm256_and_si256(in_range, bit)));
+    }
+#endif
+#if defined(PGF_STRINGS_SSE2) || defined(PGF_STRINGS_AVX2)
+    const auto below_128 = _mm_set1_epi8(First - 1);
+    const auto above_128 = _mm_set1_epi8(Last + 1);
+    const auto bit_128 = _mm_set1_epi8(case_bit);
+    for (; i + 16 <= size; i += 16)
+    {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const auto in_range = _mm_and_si128(_mm_cmpgt_epi8(chunk, below_128), _mm_cmpgt_epi8(above_128, chunk));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_xor_si128(chunk, _mm_and_si128(in_range, bit_128)));
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        const char c = in[i];
+        out[i] = (c >= First && c <= Last) ? static_cast<char>(c ^ case_bit) : c;
+    }
 }
+} // namespace
 
 std::string pg::foundation::strings::toLower(std::string_view str)
 {
-    // return std::ranges::transform_view(str, [](unsigned char c) { return std::tolower(c); });
-    std::string result;
-    result.reserve(str.size());
+    std::string result(str.size(), '\0');
+    flipCase<'A', 'Z'>(str.data(), result.data(), str.size());
+    return result;
+}
 
-    std::transform(str.begin(), str.end(), result.begin(), [](unsigned char c) {
-        return static_cast<char>(std::tolower(c));
-    }); // OK
+std::string pg::foundation::strings::toUpper(std::string_view str)
+{
+    std::string result(str.size(), '\0');
+    flipCase<'a', 'z'>(str.data(), result.data(), str.size());
     return result;
 }
+
+void pg::foundation::strings::toLowerInPlace(std::span<char> str)
+{
+    flipCase<'A', 'Z'>(str.data(), str.data(), str.size());
+}
+
+void pg::foundation::strings::toUpperInPlace(std::span<char> str)
+{
+    flipCase<'a', 'z'>(str.data(), str.data(), str.size());
+}
+
+bool pg::foundation::strings::equalsIgnoreCase(std::string_view lhs, std::string_view rhs)
+{
+    if (lhs.size() != rhs.size()) { return false; }
+    const size_t size = lhs.size();
+    size_t       i = 0;
+#if defined(PGF_STRINGS_SSE2) || defined(PGF_STRINGS_AVX2)
+    const auto below = _mm_set1_epi8('a' - 1);
+    const auto above = _mm_set1_epi8('z' + 1);
+    const auto bit = _mm_set1_epi8(0x20);
+    for (; i + 16 <= size; i += 16)
+    {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs.data() + i));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs.data() + i));
+        const auto a_lower = _mm_or_si128(a, bit);
+        const auto b_lower = _mm_or_si128(b, bit);
+        // letters compare with the case bit set on both sides, everything else exactly
+        const auto letter = _mm_and_si128(_mm_cmpgt_epi8(b_lower, below), _mm_cmpgt_epi8(above, b_lower));
+        const auto equal = _mm_or_si128(_mm_and_si128(letter, _mm_cmpeq_epi8(a_lower, b_lower)),
+                                        _mm_andnot_si128(letter, _mm_cmpeq_epi8(a, b)));
+        if (_mm_movemask_epi8(equal) != 0xffff) { return false; }
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        if (foldAscii(lhs[i]) != foldAscii(rhs[i])) { return false; }
+    }
+    return true;
+}
+
+size_t pg::foundation::strings::hashIgnoreCase(std::string_view str)
+{
+    // FNV-1a over the lower case bytes, folded in blocks to keep the hashing loop branch free
+    uint64_t hash = 14695981039346656037ull;
+    char     block[64];
+    for (size_t first = 0; first < str.size(); first += sizeof(block))
+    {
+        const auto size = std::min(sizeof(block), str.size() - first);
+        flipCase<'A', 'Z'>(str.data() + first, block, size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ static_cast<unsigned char>(block[i])) * 1099511628211ull;
+        }
+    }
+    return static_cast<size_t>(hash);
+}
@@ -1,12 +1,12 @@
 #include <pgf/taskengine/TaskEngine.hpp>
 #include <thread>
 
-void pg::foundation::TaskEngine::run()
+void pg::foundation::TaskEngine::run(std::stop_token stop_token)
 {
-    while (!runner_thread.get_stop_token().stop_requested())
+    while (!stop_token.stop_requested())
     {
         std::unique_lock lk(_mutex);
-        _cv.wait(lk, [this] { return _task_available || runner_thread.get_stop_token().stop_requested(); });
+        _cv.wait(lk, [this, &stop_token] { return _task_available || stop_token.stop_requested(); });
         while (!_tasks.empty())
         {
             auto internal_task = std::move(_tasks.front());
@@ -14,8 +14,8 @@ void pg::foundation::TaskEngine::run()
             auto success = internal_task.execute();
             if (!success && internal_task.job.reschedule_on_failure)
             {
-                _timed_tasks[std::chrono::high_resolution_clock::now() + internal_task.job.reschedule_delay] =
-                    InternalTask{std::move(internal_task)};
+                scheduleLocked(std::chrono::high_resolution_clock::now() + internal_task.job.reschedule_delay,
+                               std::move(internal_task));
             }
             _tasks.pop_front();
         }
@@ -50,21 +50,22 @@ void pg::foundation::TaskEngine::checkTimedTasks()
 void pg::foundation::TaskEngine::checkTimedTasks(const Task::TimePoint& time)
 {
     // get all delayed task with deadline passed
+    bool moved = false;
     {
         std::lock_guard lk(_mutex);
-        auto            iter = _timed_tasks.lower_bound(time);
-        // emplace all tasks from the map to the queue
-        for (auto it = _timed_tasks.begin(); it != iter; it++)
+        // move all tasks with passed deadline to the queue, their nodes are kept for the next reschedule
+        while (!_timed_tasks.empty() && _timed_tasks.begin()->first < time)
         {
-            _tasks.emplace_back(std::move(it->second));
+            auto node = _timed_tasks.extract(_timed_tasks.begin());
+            _tasks.emplace_back(std::move(node.mapped()));
+            _spare_timers.push_back(std::move(node));
+            moved = true;
         }
-        // get number of tasks that are moved to the queue
-        auto moved_tasks = std::distance(_timed_tasks.begin(), iter);
-        _timed_tasks.erase(_timed_tasks.begin(), iter);
-        _task_available = moved_tasks > 0;
-        // if there are tasks available, notify the runner thread
+        // keep the flag of tasks added directly since the last run
+        if (moved) { _task_available = true; }
     }
-    if (_task_available) { _cv.notify_all(); }
+    // if there are tasks available, notify the runner thread
+    if (moved) { _cv.notify_all(); }
 }
 
 pg::foundation::TaskEngine::TaskEngine(Config&& config)
@@ -99,21 +100,39 @@ void pg::foundation::TaskEngine::addInternalTask(InternalTask&& internal_task)
         _task_available = true;
         _cv.notify_one();
     }
-    else { _timed_tasks[internal_task.job.starting_time_offset + now] = std::move(internal_task); }
+    else { scheduleLocked(internal_task.job.starting_time_offset + now, std::move(internal_task)); }
+}
+
+void pg::foundation::TaskEngine::scheduleLocked(Task::TimePoint time, InternalTask&& task)
+{
+    // a task due at the same time as another one goes right after it instead of replacing it
+    while (_timed_tasks.contains(time))
+    {
+        time += Task::Duration{1};
+    }
+    if (_spare_timers.empty())
+    {
+        _timed_tasks.emplace(time, std::move(task));
+        return;
+    }
+    auto node = std::move(_spare_timers.back());
+    _spare_timers.pop_back();
+    node.key() = time;
+    node.mapped() = std::move(task);
+    _timed_tasks.insert(std::move(node));
 }
 
 void pg::foundation::TaskEngine::forceCheckTimedTasks()
 {
     // get all delayed task with deadline passed
     const std::lock_guard lk(_mutex);
-    auto                  iter = _timed_tasks.lower_bound(Task::TimePoint::max());
-    // emplace all tasks from the map to the queue
-    for (auto it = _timed_tasks.begin(); it != iter; it++)
+    // move all tasks to the queue, their nodes are kept for the next reschedule
+    while (!_timed_tasks.empty())
     {
-        _tasks.emplace_back(std::move(it->second));
+        auto node = _timed_tasks.extract(_timed_tasks.begin());
+        _tasks.emplace_back(std::move(node.mapped()));
+        _spare_timers.push_back(std::move(node));
     }
-
-    _timed_tasks.erase(_timed_tasks.begin(), iter);
     _task_available = true;
     _cv.notify_one();
 }
@@ -133,7 +152,7 @@ void pg::foundation::TaskEngine::addAsyncTask(Task&& task)
 void pg::foundation::TaskEngine::start()
 {
     if (runner_thread.joinable()) { throw std::logic_error("TaskEngine is already running"); }
-    runner_thread = std::jthread{&TaskEngine::run, this};
+    runner_thread = std::jthread{[this](std::stop_token stop_token) { run(stop_token); }};
     if (_config.periodic_check_duration != std::chrono::high_resolution_clock::duration::zero())
     {
         _check_thread = std::jthread([this](std::stop_token stoken) {
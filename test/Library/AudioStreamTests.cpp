@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+#include <pgf/memory/SpscRing.hpp>
+#include <pgf/streaming/AudioStream.hpp>
+#include <pgf/streaming/StreamBuffer.hpp>
+#include <atomic>
+#include <set>
+#include <thread>
+
+namespace {
+using namespace std::chrono_literals;
+
+// decodes a byte pattern of the given length in pieces smaller than a chunk
+struct PatternDecoder
+{
+    size_t total;
+    size_t position = 0;
+
+    size_t operator()(std::span<std::byte> buffer)
+    {
+        const auto count = std::min({buffer.size(), total - position, size_t{1000}});
+        for (size_t i = 0; i < count; ++i)
+        {
+            buffer[i] = static_cast<std::byte>((position + i) % 251);
+        }
+        position += count;
+        return count;
+    }
+};
+
+// stands in for an audio device, checks the pattern and refuses every third chunk as if its queue was full
+struct NullSink
+{
+    size_t received = 0;
+    size_t calls = 0;
+    bool   intact = true;
+
+    bool operator()(std::span<const std::byte> bytes)
+    {
+        if (++calls % 3 == 0) { return false; }
+        for (auto byte : bytes)
+        {
+            intact = intact && byte == static_cast<std::byte>(received++ % 251);
+        }
+        return true;
+    }
+};
+} // namespace
+
+TEST_CASE("SpscRing", "[Streaming]")
+{
+    pg::foundation::SpscRing<int> ring(3);
+    REQUIRE(ring.capacity() == 4);
+    REQUIRE(ring.tryPop() == std::nullopt);
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE(ring.tryPush(i));
+    }
+    REQUIRE_FALSE(ring.tryPush(4));
+    REQUIRE(ring.tryPop() == 0);
+    REQUIRE(ring.tryPush(4));
+    REQUIRE(ring.size() == 4);
+
+    // values arrive in order across threads
+    constexpr int count = 100000;
+    std::jthread  producer([&ring] {
+        for (int i = 5; i < count;)
+        {
+            if (ring.tryPush(i)) { ++i; }
+            else { std::this_thread::yield(); }
+        }
+    });
+    int expected = 1;
+    while (expected < count)
+    {
+        if (auto value = ring.tryPop())
+        {
+            REQUIRE(*value == expected);
+            ++expected;
+        }
+        else { std::this_thread::yield(); }
+    }
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("StreamBuffer", "[Streaming]")
+{
+    auto                         config = pg::foundation::StreamBuffer::default_config();
+    pg::foundation::StreamBuffer buffer(std::move(config.withChunkSize(64).withChunkCount(3)));
+
+    // the pool is bounded, chunks are handed out once until released
+    std::set<pg::foundation::StreamChunk*> chunks;
+    while (auto* chunk = buffer.acquire())
+    {
+        REQUIRE(chunk->data.size() == 64);
+        chunks.insert(chunk);
+    }
+    REQUIRE(chunks.size() == 3);
+    REQUIRE(buffer.next() == nullptr);
+
+    auto* first = *chunks.begin();
+    first->size = 10;
+    buffer.commit(first);
+    REQUIRE(buffer.buffered() == 1);
+    REQUIRE(buffer.next() == first);
+    REQUIRE(first->bytes().size() == 10);
+    buffer.release(first);
+    REQUIRE(buffer.acquire() == first);
+    REQUIRE(first->size == 0);
+
+    config = pg::foundation::StreamBuffer::default_config();
+    REQUIRE_THROWS_AS(pg::foundation::StreamBuffer(std::move(config.withChunkCount(0))), std::invalid_argument);
+}
+
+TEST_CASE("AudioStream", "[Streaming]")
+{
+    constexpr size_t total = 1024 * 1024 + 123;
+
+    auto engine_config = pg::foundation::TaskEngine::default_config();
+    auto stream_config = pg::foundation::AudioStream::default_config();
+    auto buffer_config = pg::foundation::StreamBuffer::default_config();
+
+    pg::foundation::TaskEngine  engine(std::move(engine_config.withPeriodicCheckDuration(1ms)));
+    NullSink                    sink;
+    stream_config.withBuffer(buffer_config.withChunkSize(4096).withChunkCount(4)).withRefillInterval(1ms);
+    pg::foundation::AudioStream stream(PatternDecoder{total}, std::ref(sink), std::move(stream_config));
+    stream.start(engine);
+    REQUIRE_THROWS_AS(stream.start(engine), std::logic_error);
+
+    const auto deadline = std::chrono::steady_clock::now() + 30s;
+    while (!stream.finished() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    engine.wait();
+
+    REQUIRE(stream.finished());
+    REQUIRE(stream.bytesDecoded() == total);
+    REQUIRE(stream.bytesDelivered() == total);
+    REQUIRE(sink.received == total);
+    REQUIRE(sink.intact);
+    REQUIRE(stream.buffer().buffered() == 0);
+}
+
+TEST_CASE("AudioStream stop", "[Streaming]")
+{
+    auto                       config = pg::foundation::TaskEngine::default_config();
+    pg::foundation::TaskEngine engine(std::move(config.withPeriodicCheckDuration(1ms)));
+    std::atomic<size_t>        decoded{0};
+    std::atomic<size_t>        delivered{0};
+    {
+        // an endless stream into a sink that never takes anything
+        pg::foundation::AudioStream stream(
+            [&decoded](std::span<std::byte> buffer) {
+                ++decoded;
+                return buffer.size();
+            },
+            [&delivered](std::span<const std::byte>) {
+                ++delivered;
+                return false;
+            });
+        stream.start(engine);
+
+        const auto filled = stream.buffer().chunkSize() * stream.buffer().chunkCount();
+        const auto deadline = std::chrono::steady_clock::now() + 30s;
+        while ((stream.bytesDecoded() < filled || delivered == 0) && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        REQUIRE(stream.bytesDecoded() == filled);
+        REQUIRE(delivered > 0);
+        REQUIRE_FALSE(stream.finished());
+    }
+    // neither the decoder nor the sink is called once the stream is gone, the task ends on its next run
+    const size_t decodes = decoded;
+    const size_t deliveries = delivered;
+    engine.wait();
+    REQUIRE(decoded == decodes);
+    REQUIRE(delivered == deliveries);
+}
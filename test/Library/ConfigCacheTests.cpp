@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <pgf/serialization/ConfigCache.hpp>
+#include <pgf/serialization/Yaml2Json.hpp>
+
+namespace {
+std::filesystem::path writeTempFile(const std::string& name, std::string_view content)
+{
+    auto          path = std::filesystem::temp_directory_path() / name;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    return path;
+}
+} // namespace
+
+TEST_CASE("ConfigCache", "[Sidecar]")
+{
+    auto                        path = writeTempFile("pgf_config_cache.yaml", "name: forest\nsize: [1, 2]\n");
+    pg::foundation::ConfigCache cache;
+    cache.invalidate(path);
+
+    const nlohmann::json expected{{"name", "forest"}, {"size", {1, 2}}};
+    REQUIRE(cache.load(path) == expected);
+    REQUIRE(cache.misses() == 1);
+    REQUIRE(std::filesystem::exists(cache.sidecarPath(path)));
+
+    REQUIRE(cache.load(path) == expected);
+    REQUIRE(cache.hits() == 1);
+
+    // a changed source is converted again
+    writeTempFile("pgf_config_cache.yaml", "name: desert\nsize: [3, 4]\n");
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+    REQUIRE(cache.load(path)["name"] == "desert");
+    REQUIRE(cache.misses() == 2);
+    REQUIRE(cache.load(path)["name"] == "desert");
+    REQUIRE(cache.hits() == 2);
+
+    REQUIRE(cache.invalidate(path));
+    REQUIRE_FALSE(cache.invalidate(path));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ConfigCache", "[Content hash]")
+{
+    // same size and modification time, only the hash tells the difference
+    auto       path = writeTempFile("pgf_config_cache_hash.yaml", "value: 1\n");
+    const auto mtime = std::filesystem::last_write_time(path);
+
+    auto directory = std::filesystem::temp_directory_path() / "pgf_config_cache";
+    auto config = pg::foundation::ConfigCache::default_config();
+    config.withCacheDirectory(directory).withFormat(pg::foundation::config_cache::Format::MessagePack);
+    pg::foundation::ConfigCache cache(std::move(config));
+    cache.invalidate(path);
+    REQUIRE(cache.sidecarPath(path).parent_path() == directory);
+
+    REQUIRE(cache.load(path)["value"] == 1);
+    writeTempFile("pgf_config_cache_hash.yaml", "value: 2\n");
+    std::filesystem::last_write_time(path, mtime);
+    REQUIRE(cache.load(path)["value"] == 2);
+    REQUIRE(cache.misses() == 2);
+
+    auto unchecked = pg::foundation::ConfigCache::default_config();
+    unchecked.withCacheDirectory(directory).withVerifyHash(false);
+    pg::foundation::ConfigCache fast(std::move(unchecked));
+    REQUIRE(fast.load(path)["value"] == 2);
+    REQUIRE(fast.hits() == 1);
+
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ConfigCache", "[Corrupt sidecar]")
+{
+    auto                        path = writeTempFile("pgf_config_cache_corrupt.yaml", "a: 1\n");
+    pg::foundation::ConfigCache cache;
+    writeTempFile("pgf_config_cache_corrupt.yaml.pgfconf", "PGFCONF garbage");
+    REQUIRE(cache.load(path)["a"] == 1);
+    REQUIRE(cache.misses() == 1);
+    REQUIRE(cache.load(path)["a"] == 1);
+    REQUIRE(cache.hits() == 1);
+
+    REQUIRE_THROWS(cache.load(std::filesystem::temp_directory_path() / "pgf_config_cache_missing.yaml"));
+    cache.invalidate(path);
+    std::filesystem::remove(path);
+}
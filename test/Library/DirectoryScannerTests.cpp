@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <pgf/filesystem/DirectoryScanner.hpp>
+#include <pgf/filesystem/directory.hpp>
+#include <pgf/strings/PatternSet.hpp>
+
+namespace {
+using Paths = std::vector<std::string_view>;
+
+std::filesystem::path makeTree()
+{
+    auto root = std::filesystem::temp_directory_path() / "pgf_directory_scanner";
+    std::filesystem::remove_all(root);
+    for (const auto* file : {"readme.md",
+                             "textures/grass.png",
+                             "textures/stone.PNG",
+                             "textures/ui/button.png",
+                             "sounds/step.wav",
+                             "sounds/music/theme.ogg",
+                             "empty/.keep"})
+    {
+        std::filesystem::create_directories((root / file).parent_path());
+        std::ofstream(root / file) << file;
+    }
+    std::filesystem::create_directories(root / "levels/a/b/c");
+    return root;
+}
+} // namespace
+
+TEST_CASE("DirectoryScanner", "[Snapshot]")
+{
+    const auto root = makeTree();
+    for (size_t threads : {1, 4})
+    {
+        auto       config = pg::foundation::DirectoryScanner::default_config();
+        const auto snapshot = pg::foundation::DirectoryScanner(std::move(config.withMaxThreads(threads))).scan(root);
+
+        REQUIRE(snapshot.files() == std::vector<std::string>{"empty/.keep",
+                                                              "readme.md",
+                                                              "sounds/music/theme.ogg",
+                                                              "sounds/step.wav",
+                                                              "textures/grass.png",
+                                                              "textures/stone.PNG",
+                                                              "textures/ui/button.png"});
+        REQUIRE(snapshot.directories().size() == 10);
+        REQUIRE(snapshot.leafDirectories() == Paths{"empty", "levels/a/b/c", "sounds/music", "textures/ui"});
+        REQUIRE(snapshot.isLeafDirectory("textures/ui"));
+        REQUIRE_FALSE(snapshot.isLeafDirectory(""));
+        REQUIRE_FALSE(snapshot.isLeafDirectory("levels/a"));
+        REQUIRE_THROWS_AS(snapshot.isLeafDirectory("missing"), std::out_of_range);
+        REQUIRE(snapshot.findDirectory("textures")->file_count == 2);
+
+        REQUIRE(snapshot.filesWithExtension(".png") == Paths{"textures/grass.png", "textures/ui/button.png"});
+        REQUIRE(snapshot.filesWithExtension(".png", false).size() == 3);
+        REQUIRE(snapshot.filesWithExtension("").size() == 1);
+
+        REQUIRE(snapshot.glob("sounds/*") == Paths{"sounds/music/theme.ogg", "sounds/step.wav"});
+        REQUIRE(snapshot.glob("*/stone.png", false) == Paths{"textures/stone.PNG"});
+        REQUIRE(snapshot.glob(pg::foundation::strings::PatternSet({"*.ogg", "*.md"})) ==
+                Paths{"readme.md", "sounds/music/theme.ogg"});
+        REQUIRE(snapshot.absolute("readme.md") == root / "readme.md");
+    }
+    REQUIRE_THROWS_AS(pg::foundation::DirectoryScanner().scan(root / "missing"), std::runtime_error);
+
+    // the single level helpers agree
+    REQUIRE(pg::foundation::isLeafDirectory(root / "textures/ui"));
+    auto leafs = pg::foundation::getLeafSubDirectories(root / "sounds");
+    REQUIRE(leafs == std::vector<std::filesystem::path>{root / "sounds/music"});
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("DirectoryScanner", "[Large tree]")
+{
+    auto root = std::filesystem::temp_directory_path() / "pgf_directory_scanner_large";
+    std::filesystem::remove_all(root);
+    for (int i = 0; i < 20; ++i)
+    {
+        for (int j = 0; j < 10; ++j)
+        {
+            auto directory = root / std::to_string(i) / std::to_string(j);
+            std::filesystem::create_directories(directory);
+            std::ofstream(directory / "file.txt") << i << j;
+        }
+    }
+    size_t expected_files = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root))
+    {
+        expected_files += entry.is_regular_file() ? 1 : 0;
+    }
+
+    const auto snapshot = pg::foundation::DirectoryScanner().scan(root);
+    REQUIRE(snapshot.files().size() == expected_files);
+    REQUIRE(snapshot.leafDirectories().size() == 200);
+    REQUIRE(snapshot.directories().size() == 221);
+    std::filesystem::remove_all(root);
+}
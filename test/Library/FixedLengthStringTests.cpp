@@ -0,0 +1,56 @@
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <pgf/strings/FixedLengthString.hpp>
+
+using pg::foundation::strings::FixedLengthString;
+
+static_assert(std::is_trivially_copyable_v<FixedLengthString<16>>);
+static_assert(sizeof(FixedLengthString<15>) == 16);
+static_assert(FixedLengthString<8>("abc").size() == 3);
+static_assert(FixedLengthString<8>("abc") == std::string_view{"abc"});
+static_assert(FixedLengthString<8>("abc") < FixedLengthString<8>("abd"));
+
+TEST_CASE("FixedLengthString", "[FixedLengthString]")
+{
+    FixedLengthString<8> id("texture");
+    REQUIRE(id.size() == 7);
+    REQUIRE(id == std::string_view{"texture"});
+    REQUIRE(std::string(id) == "texture");
+    REQUIRE(std::strcmp(static_cast<const char*>(id), "texture") == 0);
+
+    FixedLengthString<8> full("12345678");
+    REQUIRE(full.size() == 8);
+    REQUIRE(std::string_view(full) == "12345678");
+
+    REQUIRE(FixedLengthString<8>(std::string_view("ab\0cd", 5)) == std::string_view{"ab"});
+    REQUIRE(FixedLengthString<8>().empty());
+    REQUIRE_THROWS_AS(FixedLengthString<4>("too long"), std::out_of_range);
+
+    // copies and moves keep referring to their own storage
+    auto copy = id;
+    auto moved = std::move(copy);
+    id = "other";
+    REQUIRE(moved == std::string_view{"texture"});
+    REQUIRE(moved.view().data() == moved.data());
+
+    // equal strings are equal bytes
+    FixedLengthString<8> a("ab");
+    FixedLengthString<8> b(std::string("abc").substr(0, 2));
+    REQUIRE(a == b);
+    REQUIRE(std::memcmp(&a, &b, sizeof(a)) == 0);
+    REQUIRE(a < FixedLengthString<8>("b"));
+}
+
+TEST_CASE("FixedLengthString in containers", "[FixedLengthString]")
+{
+    std::vector<FixedLengthString<16>> ids{"grass", "stone", "water"};
+    std::vector<FixedLengthString<16>> copy(ids.size());
+    std::memcpy(copy.data(), ids.data(), ids.size() * sizeof(ids[0]));
+    REQUIRE(copy == ids);
+
+    std::unordered_set<FixedLengthString<16>> set(ids.begin(), ids.end());
+    REQUIRE(set.contains("stone"));
+    REQUIRE_FALSE(set.contains("sand"));
+}
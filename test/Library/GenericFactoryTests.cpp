@@ -1,4 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <pgf/caching/ConcurrentGenericFactory.hpp>
 #include <pgf/caching/GenericFactory.hpp>
 
 class Simple
@@ -81,3 +83,189 @@ TEST_CASE("GenericFactory", "[Multiple  Mixed Parameter]")
     REQUIRE(simple->_i == 42);
     REQUIRE(simple->_j == 43);
 }
+
+TEST_CASE("GenericFactory", "[Frozen]")
+{
+    auto factory = pg::foundation::GenericFactory<SimpleTwo, int>();
+    factory.registerPrototype("one", pg::foundation::GenericFactory<SimpleTwo, int>::proto(1));
+    factory.registerPrototype("two", pg::foundation::GenericFactory<SimpleTwo, int>::proto(2));
+    factory.freeze();
+
+    REQUIRE(factory.isFrozen());
+    REQUIRE(factory.hasPrototypeName("two"));
+    REQUIRE_FALSE(factory.hasPrototypeName("three"));
+    REQUIRE_THROWS_AS(factory.registerPrototype("three", pg::foundation::GenericFactory<SimpleTwo, int>::proto(3)),
+                      std::logic_error);
+    REQUIRE_THROWS_AS(factory.keyId("three"), std::out_of_range);
+
+    // make by name and by id yield the same prototype
+    auto id = factory.keyId("two");
+    REQUIRE(factory.make("two", 42)->_j == 2);
+    REQUIRE(factory.make(id, 42)->_j == 2);
+    REQUIRE(factory.make(factory.keyId("one"), 42)->_j == 1);
+
+    // copies are frozen on their own table
+    auto copy = factory;
+    factory = {};
+    REQUIRE(copy.make(id, 42)->_i == 42);
+}
+
+class Particle
+{
+public:
+    Particle(int i)
+      : _i(i)
+    {
+        ++alive;
+    }
+
+    virtual ~Particle() { --alive; }
+
+    int _i;
+
+    static inline int alive = 0;
+};
+
+class SparkParticle : public Particle
+{
+public:
+    SparkParticle(int i, int brightness)
+      : Particle(i)
+      , _brightness(brightness)
+    {
+    }
+
+    int _brightness;
+};
+
+TEST_CASE("GenericFactory", "[Pooled]")
+{
+    using Factory = pg::foundation::GenericFactory<Particle, int>;
+    auto factory = Factory();
+    factory.registerPrototype("particle", Factory::pooledProto<8>());
+    factory.registerPrototype("spark", pg::foundation::GenericFactory<SparkParticle, int>::pooledProto<8>(7));
+    factory.registerPrototype("plain", Factory::proto());
+    {
+        auto first = factory.make("particle", 1);
+        auto second = factory.make("particle", 2);
+        auto spark = factory.make("spark", 3);
+        REQUIRE(first->_i == 1);
+        REQUIRE(second->_i == 2);
+        REQUIRE(dynamic_cast<SparkParticle*>(spark.get())->_brightness == 7);
+        REQUIRE(Particle::alive == 3);
+    }
+    REQUIRE(Particle::alive == 0);
+
+    // the pool outlives the factory as long as objects are alive
+    auto survivor = factory.make("particle", 4);
+    factory = Factory();
+    REQUIRE(survivor->_i == 4);
+    survivor.reset();
+    REQUIRE(Particle::alive == 0);
+}
+
+TEST_CASE("GenericFactory", "[MakeN]")
+{
+    using Factory = pg::foundation::GenericFactory<Particle, int>;
+    auto factory = Factory();
+    factory.registerPrototype("particle", Factory::pooledProto<4>());
+    factory.registerPrototype("plain", Factory::proto());
+
+    auto pooled = factory.makeN("particle", 10, 5);
+    REQUIRE(pooled.size() == 10);
+    REQUIRE(Particle::alive == 10);
+    // constructed into adjacent slots
+    auto stride = reinterpret_cast<std::byte*>(pooled[1].get()) - reinterpret_cast<std::byte*>(pooled[0].get());
+    for (size_t i = 1; i < pooled.size(); ++i)
+    {
+        REQUIRE(pooled[i]->_i == 5);
+        REQUIRE(reinterpret_cast<std::byte*>(pooled[i].get()) - reinterpret_cast<std::byte*>(pooled[i - 1].get()) ==
+                stride);
+    }
+
+    // arguments are converted to the factory's argument types
+    auto converted = factory.makeN("particle", 2, 5u);
+    REQUIRE(converted[1]->_i == 5);
+    converted.clear();
+
+    factory.freeze();
+    auto plain = factory.makeN(factory.keyId("plain"), 3, 6);
+    REQUIRE(plain.size() == 3);
+    REQUIRE(plain[2]->_i == 6);
+
+    pooled.clear();
+    plain.clear();
+    REQUIRE(Particle::alive == 0);
+}
+
+TEST_CASE("GenericFactory", "[Pooled move-only argument]")
+{
+    struct Holder
+    {
+        Holder(std::unique_ptr<int> v)
+          : value(std::move(v))
+        {
+        }
+
+        std::unique_ptr<int> value;
+    };
+
+    // pooled prototypes register without bulk construction
+    using Factory = pg::foundation::GenericFactory<Holder, std::unique_ptr<int>>;
+    static_assert(!Factory::is_bulk_constructible);
+    auto factory = Factory();
+    REQUIRE(factory.registerPrototype("holder", Factory::pooledProto()));
+    REQUIRE(*factory.make("holder", std::make_unique<int>(3))->value == 3);
+}
+
+TEST_CASE("ConcurrentGenericFactory", "[Concurrent registration]")
+{
+    using Factory = pg::foundation::GenericFactory<Simple, int>;
+    pg::foundation::ConcurrentGenericFactory<Simple, int> factory;
+    factory.registerPrototype("simple", Factory::proto());
+
+    std::atomic<bool> failed{false};
+    std::atomic<int>  made{0};
+    {
+        std::vector<std::jthread> readers;
+        for (int t = 0; t < 4; ++t)
+        {
+            readers.emplace_back([&factory, &failed, &made] {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    if (factory.make("simple", int{i})->_i != i) { failed = true; }
+                    ++made;
+                }
+            });
+        }
+        factory.update([](Factory& f) {
+            for (int i = 0; i < 16; ++i)
+            {
+                f.registerPrototype(std::format("plugin{}", i), Factory::proto());
+            }
+        });
+    }
+    REQUIRE_FALSE(failed);
+    REQUIRE(made == 4000);
+    REQUIRE(factory.hasPrototypeName("plugin15"));
+    REQUIRE_FALSE(factory.registerPrototype("simple", Factory::proto()));
+
+    const auto snapshot = factory.snapshot();
+    REQUIRE(snapshot->make(snapshot->keyId("plugin3"), 3)->_i == 3);
+}
+
+TEST_CASE("ConcurrentGenericFactory", "[Snapshot reclamation]")
+{
+    using Factory = pg::foundation::GenericFactory<Simple, int>;
+    pg::foundation::ConcurrentGenericFactory<Simple, int> factory;
+
+    // every copy of the prototype holds a reference: the caller, the staging registry and the current snapshot
+    auto tracker = std::make_shared<int>(0);
+    factory.registerPrototype("tracked", [tracker](int&& i) { return std::make_unique<Simple>(i); });
+    for (int i = 0; i < 16; ++i)
+    {
+        factory.registerPrototype(std::format("plugin{}", i), Factory::proto());
+    }
+    REQUIRE(tracker.use_count() == 3);
+    REQUIRE(factory.make("tracked", 4)->_i == 4);
+}
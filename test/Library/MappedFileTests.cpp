@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <pgf/filesystem/MappedFile.hpp>
+
+namespace {
+std::filesystem::path writeTempFile(const std::string& name, std::string_view content)
+{
+    auto          path = std::filesystem::temp_directory_path() / name;
+    std::ofstream out(path, std::ios::binary);
+    out.write(content.data(), static_cast<std::streamsize>(content.size()));
+    return path;
+}
+} // namespace
+
+TEST_CASE("MappedFile", "[Content]")
+{
+    auto path = writeTempFile("pgf_mapped_file_content.bin", "hello mapped world");
+
+    pg::foundation::MappedFile file(path);
+    REQUIRE(file.size() == 18);
+    REQUIRE(file.view() == "hello mapped world");
+    file.advise(pg::foundation::MappedFile::Access::WillNeed);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("MappedFile", "[Slice]")
+{
+    auto path = writeTempFile("pgf_mapped_file_slice.bin", "hello mapped world");
+
+    pg::foundation::MappedFile slice;
+    {
+        pg::foundation::MappedFile file(path);
+        slice = file.slice(6, 6);
+        REQUIRE_THROWS_AS(file.slice(10, 9), std::out_of_range);
+    }
+    // the slice keeps the mapping alive
+    REQUIRE(slice.view() == "mapped");
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("MappedFile", "[Empty and missing]")
+{
+    auto path = writeTempFile("pgf_mapped_file_empty.bin", "");
+
+    pg::foundation::MappedFile file(path);
+    REQUIRE(file.empty());
+    REQUIRE_THROWS_AS(pg::foundation::MappedFile(path.string() + ".missing"), std::system_error);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include <pgf/memory/ObjectPool.hpp>
+
+namespace {
+struct Particle
+{
+    float position[3];
+    int   id;
+};
+
+using Pool = pg::foundation::ObjectPool<Particle, 16>;
+
+void deallocateRun(Pool& pool, std::byte* run, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        pool.deallocate(run + i * Pool::stride());
+    }
+}
+} // namespace
+
+TEST_CASE("ObjectPool", "[Contiguous churn]")
+{
+    auto* pool = Pool::create();
+
+    // freed runs are reused, so the pool does not grow with the number of rounds
+    for (int round = 0; round < 1000; ++round)
+    {
+        auto* first = pool->allocateContiguous(256);
+        auto* second = pool->allocateContiguous(100);
+        deallocateRun(*pool, first, 256);
+        deallocateRun(*pool, second, 100);
+        REQUIRE(pool->chunkCount() <= 2);
+    }
+
+    // a spare fits smaller runs, larger runs replace the spares that are too small
+    auto* run = pool->allocateContiguous(200);
+    deallocateRun(*pool, run, 200);
+    run = pool->allocateContiguous(1024);
+    REQUIRE(pool->chunkCount() == 1);
+    deallocateRun(*pool, run, 1024);
+
+    // single objects still come from their own chunks
+    std::vector<void*> singles;
+    for (int i = 0; i < 20; ++i)
+    {
+        singles.push_back(pool->allocate());
+    }
+    REQUIRE(pool->chunkCount() == 3);
+    for (auto* single : singles)
+    {
+        pool->deallocate(single);
+    }
+    pool->release();
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <fstream>
+#include <pgf/caching/PackArchive.hpp>
+
+namespace {
+std::filesystem::path makeResourceTree()
+{
+    auto root = std::filesystem::temp_directory_path() / "pgf_pack_tests";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "sounds");
+    std::ofstream(root / "a.txt") << "alpha";
+    std::ofstream(root / "sounds" / "b.txt") << "bravo bravo";
+    std::ofstream(root / "empty.txt");
+    return root;
+}
+} // namespace
+
+TEST_CASE("PackArchive", "[Roundtrip]")
+{
+    auto root = makeResourceTree();
+    auto archive_path = root.parent_path() / "pgf_pack_tests.pack";
+
+    pg::foundation::PackWriter writer;
+    writer.addDirectory(root);
+    writer.write(archive_path, 64);
+
+    pg::foundation::PackArchive archive(archive_path);
+    REQUIRE(archive.size() == 3);
+    REQUIRE(archive.contains("a.txt"));
+    REQUIRE(archive.contains("sounds/b.txt"));
+    REQUIRE_FALSE(archive.contains("sounds/c.txt"));
+
+    auto bravo = archive.open("sounds/b.txt");
+    REQUIRE(bravo.view() == "bravo bravo");
+    REQUIRE(reinterpret_cast<uintptr_t>(bravo.data()) % 64 == 0);
+    REQUIRE(archive.open("a.txt").view() == "alpha");
+    REQUIRE(archive.open("empty.txt").empty());
+    REQUIRE_THROWS_AS(archive.open("missing"), std::out_of_range);
+
+    std::filesystem::remove_all(root);
+    std::filesystem::remove(archive_path);
+}
+
+TEST_CASE("PackArchive", "[Duplicates]")
+{
+    auto root = makeResourceTree();
+
+    pg::foundation::PackWriter writer;
+    writer.add("a", root / "a.txt");
+    writer.add("a", root / "sounds" / "b.txt");
+    REQUIRE_THROWS_AS(writer.write(root.parent_path() / "pgf_pack_duplicates.pack"), std::invalid_argument);
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("PackArchive", "[Corrupt index]")
+{
+    auto root = makeResourceTree();
+    auto archive_path = root.parent_path() / "pgf_pack_corrupt.pack";
+
+    pg::foundation::PackWriter writer;
+    writer.addDirectory(root);
+    writer.write(archive_path);
+
+    // offsets that only fit when the bounds check wraps around
+    auto corrupt = [&archive_path](size_t position, uint64_t value) {
+        std::fstream file(archive_path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(position));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    const auto first_entry = sizeof(pg::foundation::pack::Header);
+    corrupt(first_entry + offsetof(pg::foundation::pack::IndexEntry, offset), UINT64_MAX - 1);
+    corrupt(first_entry + offsetof(pg::foundation::pack::IndexEntry, size), 16);
+    REQUIRE_THROWS_AS(pg::foundation::PackArchive(archive_path), std::runtime_error);
+
+    writer.write(archive_path);
+    corrupt(offsetof(pg::foundation::pack::Header, names_size), UINT64_MAX - 8);
+    REQUIRE_THROWS_AS(pg::foundation::PackArchive(archive_path), std::runtime_error);
+
+    std::filesystem::remove_all(root);
+    std::filesystem::remove(archive_path);
+}
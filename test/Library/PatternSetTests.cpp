@@ -0,0 +1,63 @@
+#include <random>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include <pgf/strings/PatternSet.hpp>
+#include <pgf/strings/StringTools.hpp>
+
+using namespace pg::foundation::strings;
+
+TEST_CASE("PatternSet", "[PatternSet]")
+{
+    PatternSet set({"*.tmp", "build/*", "*~", "tile_??.png", "", "*"});
+    REQUIRE(set.size() == 6);
+
+    REQUIRE(set.firstMatch("a.tmp") == 0);
+    REQUIRE(set.allMatches("a.tmp") == std::vector<size_t>{0, 5});
+    REQUIRE(set.allMatches("build/a.tmp") == std::vector<size_t>{0, 1, 5});
+    REQUIRE(set.allMatches("tile_01.png") == std::vector<size_t>{3, 5});
+    REQUIRE(set.allMatches("tile_1.png") == std::vector<size_t>{5});
+    REQUIRE(set.allMatches("") == std::vector<size_t>{4, 5});
+
+    PatternSet excludes({"*.tmp", "build/*"});
+    REQUIRE_FALSE(excludes.matchesAny("src/main.cpp"));
+    REQUIRE_FALSE(excludes.firstMatch("a.tmp.txt").has_value());
+    REQUIRE_FALSE(PatternSet{}.matchesAny("anything"));
+}
+
+TEST_CASE("PatternSet case insensitive", "[PatternSet]")
+{
+    PatternSet set({"*.PNG", "Readme*"}, false);
+    REQUIRE(set.allMatches("README.png") == std::vector<size_t>{0, 1});
+    REQUIRE_FALSE(PatternSet({"*.PNG"}).matchesAny("a.png"));
+}
+
+TEST_CASE("PatternSet agrees with WildcardPattern", "[PatternSet]")
+{
+    // enough patterns to span several words of states
+    std::mt19937 random(42);
+    auto         randomString = [&random](std::string_view alphabet, size_t max_length) {
+        std::string result(random() % (max_length + 1), ' ');
+        for (auto& c : result)
+        {
+            c = alphabet[random() % alphabet.size()];
+        }
+        return result;
+    };
+    std::vector<std::string> patterns;
+    PatternSet               set;
+    for (int i = 0; i < 200; ++i)
+    {
+        patterns.push_back(randomString("ab?*", 6));
+        REQUIRE(set.add(patterns.back()) == patterns.size() - 1);
+    }
+    for (int i = 0; i < 500; ++i)
+    {
+        const auto          input = randomString("ab", 10);
+        std::vector<size_t> expected;
+        for (size_t p = 0; p < patterns.size(); ++p)
+        {
+            if (WildcardPattern(patterns[p]).matches(input)) { expected.push_back(p); }
+        }
+        REQUIRE(set.allMatches(input) == expected);
+    }
+}
@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <pgf/caching/ResourceLocator.hpp>
+
+namespace {
+std::filesystem::path makeRoots()
+{
+    auto base = std::filesystem::temp_directory_path() / "pgf_locator_tests";
+    std::filesystem::remove_all(base);
+    std::filesystem::create_directories(base / "mod" / "sounds");
+    std::filesystem::create_directories(base / "game" / "sounds");
+    std::ofstream(base / "mod" / "sounds" / "bang.wav") << "mod";
+    std::ofstream(base / "game" / "sounds" / "bang.wav") << "game";
+    std::ofstream(base / "game" / "sounds" / "boom.wav") << "game";
+    std::ofstream(base / "game" / "level.json") << "{}";
+    return base;
+}
+} // namespace
+
+TEST_CASE("IndexedResourceLocator", "[Shadowing]")
+{
+    auto base = makeRoots();
+
+    pg::foundation::IndexedResourceLocator locator({base / "mod", base / "game"});
+    REQUIRE(locator.size() == 3);
+    REQUIRE(locator.contains("sounds/bang.wav"));
+    REQUIRE(locator.locate("sounds/bang.wav") == base / "mod" / "sounds" / "bang.wav");
+    REQUIRE(locator.locate("sounds/boom.wav") == base / "game" / "sounds" / "boom.wav");
+    REQUIRE_FALSE(locator.contains("sounds/missing.wav"));
+    REQUIRE_THROWS_AS(locator.locate("sounds/missing.wav"), std::out_of_range);
+
+    std::filesystem::remove_all(base);
+}
+
+TEST_CASE("IndexedResourceLocator", "[Refresh]")
+{
+    auto base = makeRoots();
+
+    pg::foundation::IndexedResourceLocator locator({base / "mod", base / "game"});
+
+    std::filesystem::remove(base / "mod" / "sounds" / "bang.wav");
+    std::ofstream(base / "mod" / "sounds" / "zap.wav") << "mod";
+    std::filesystem::remove(base / "game" / "level.json");
+    // only the sounds are rescanned, the stale level stays indexed
+    locator.refresh("sounds");
+    REQUIRE(locator.locate("sounds/bang.wav") == base / "game" / "sounds" / "bang.wav");
+    REQUIRE(locator.contains("sounds/zap.wav"));
+    REQUIRE(locator.contains("level.json"));
+
+    locator.refreshUri("level.json");
+    REQUIRE_FALSE(locator.contains("level.json"));
+
+    // "." rescans everything, deleted files are dropped
+    std::filesystem::remove(base / "mod" / "sounds" / "zap.wav");
+    for (const auto* root : {".", "./"})
+    {
+        locator.refresh(root);
+        REQUIRE_FALSE(locator.contains("sounds/zap.wav"));
+        REQUIRE(locator.contains("sounds/bang.wav"));
+        REQUIRE_FALSE(locator.contains("./sounds/bang.wav"));
+    }
+
+    std::filesystem::remove_all(base);
+}
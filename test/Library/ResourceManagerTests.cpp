@@ -0,0 +1,234 @@
+#include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <pgf/caching/PrefetchManifest.hpp>
+#include <pgf/caching/ResourceManager.hpp>
+
+struct TextResource
+{
+    std::string text;
+};
+
+template <>
+inline auto pg::foundation::loadResource<TextResource>(const std::string& path) -> TextResource
+{
+    std::ifstream in(path);
+    std::string   text;
+    std::getline(in, text);
+    if (text.empty()) { throw std::runtime_error("empty resource"); }
+    return TextResource{text};
+}
+
+// skips the first characters of the text
+template <>
+inline auto pg::foundation::loadResource<TextResource, int>(const std::string& path, int skip) -> TextResource
+{
+    auto resource = loadResource<TextResource>(path);
+    resource.text.erase(0, static_cast<size_t>(skip));
+    return resource;
+}
+
+namespace {
+std::filesystem::path makeResourceDirectory(size_t count)
+{
+    auto root = std::filesystem::temp_directory_path() / "pgf_resource_manager_tests";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::ofstream(root / std::to_string(i)) << "resource " << i;
+    }
+    return root;
+}
+} // namespace
+
+TEST_CASE("ResourceManager", "[Prefetch]")
+{
+    auto                     root = makeResourceDirectory(32);
+    std::vector<std::string> uris;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        uris.push_back((root / std::to_string(i)).string());
+    }
+
+    pg::foundation::ResourceManager<pg::foundation::IdentityResourceLocator> manager;
+
+    // catch assertions are not thread safe, only record the progress in the callback
+    std::atomic<size_t>            calls{0};
+    std::atomic<size_t>            finished{0};
+    std::atomic<size_t>            reported_total{0};
+    pg::foundation::PrefetchConfig config;
+    config.withMaxConcurrency(4).withProgress([&](size_t done, size_t total) {
+        reported_total = total;
+        calls.fetch_add(1);
+        auto current = finished.load();
+        while (current < done && !finished.compare_exchange_weak(current, done))
+        {
+        }
+    });
+    manager.prefetch<TextResource>(uris, std::move(config));
+
+    REQUIRE(reported_total == 32);
+    REQUIRE(calls == 32);
+    REQUIRE(finished == 32);
+    REQUIRE(manager.load<TextResource>(uris[7])->text == "resource 7");
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("ResourceManager", "[Prefetch failure]")
+{
+    auto root = makeResourceDirectory(2);
+    std::ofstream(root / "empty");
+
+    pg::foundation::ResourceManager<pg::foundation::IdentityResourceLocator> manager;
+
+    std::vector<std::string> uris{(root / "0").string(), (root / "empty").string(), (root / "1").string()};
+    REQUIRE_THROWS_AS(manager.prefetch<TextResource>(uris), std::runtime_error);
+    // the remaining resources are loaded regardless
+    REQUIRE(manager.load<TextResource>(uris[2])->text == "resource 1");
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("ResourceManager", "[Statistics]")
+{
+    auto root = makeResourceDirectory(2);
+    auto uri = (root / "0").string();
+
+    pg::foundation::ResourceManager<pg::foundation::IdentityResourceLocator> manager;
+    manager.enableStatistics();
+
+    manager.load<TextResource>(uri);
+    manager.load<TextResource>(uri);
+    manager.load<TextResource>(uri);
+    manager.load<pg::foundation::MappedFile>((root / "1").string());
+    manager.evict(uri);
+
+    auto json = manager.statisticsJson();
+    REQUIRE(json["total"]["misses"] == 2);
+    REQUIRE(json["total"]["evictions"] == 1);
+
+    auto text = json["types"]["TextResource"];
+    REQUIRE(text["hits"] == 2);
+    REQUIRE(text["misses"] == 1);
+    REQUIRE(text["loads"] == 1);
+    REQUIRE(text["bytes_resident"] == 0);
+    REQUIRE(json["types"]["pg::foundation::MappedFile"]["bytes_resident"] == std::string_view("resource 1").size());
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("ResourceManager", "[Prefetch manifest]")
+{
+    auto manifest = pg::foundation::PrefetchManifest::fromYaml(
+        YAML::Load(R"({"concurrency": 3, "groups": {"sounds": ["a.wav", "b.wav"], "levels": ["1.json"]}})"));
+
+    REQUIRE(manifest.concurrency == 3);
+    REQUIRE(manifest.size() == 3);
+    REQUIRE(manifest.group("sounds").size() == 2);
+    REQUIRE(manifest.group("textures").empty());
+}
+
+#ifdef __linux__
+TEST_CASE("ResourceManager", "[Hot reload]")
+{
+    auto root = makeResourceDirectory(2);
+    auto uri = (root / "0").string();
+
+    pg::foundation::ResourceManager<pg::foundation::IdentityResourceLocator> manager;
+    auto config = pg::foundation::ResourceWatcher::default_config().withDebounce(std::chrono::milliseconds(10));
+    manager.enableHotReload(std::move(config));
+
+    std::vector<std::pair<std::string, uint64_t>> reloads;
+    manager.onReload([&reloads](const std::string& u, uint64_t generation) { reloads.emplace_back(u, generation); });
+
+    auto first = manager.load<TextResource>(uri);
+    REQUIRE(manager.generation(uri) == 0);
+
+    std::ofstream(uri) << "changed";
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (manager.processReloads() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    REQUIRE(manager.generation(uri) == 1);
+    REQUIRE(reloads.size() == 1);
+    REQUIRE(reloads.front().first == uri);
+    REQUIRE(manager.load<TextResource>(uri)->text == "changed");
+    // the previous version stays valid for its holders
+    REQUIRE(first->text == "resource 0");
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("ResourceManager", "[Hot reload after failed load]")
+{
+    auto root = makeResourceDirectory(0);
+    auto uri = (root / "empty").string();
+    std::ofstream(uri).flush();
+
+    pg::foundation::ResourceManager<pg::foundation::IdentityResourceLocator> manager;
+    auto config = pg::foundation::ResourceWatcher::default_config().withDebounce(std::chrono::milliseconds(10));
+    manager.enableHotReload(std::move(config));
+
+    REQUIRE_THROWS_AS(manager.load<TextResource>(uri, 0), std::runtime_error);
+
+    // a resource that never loaded is not reloaded into the cache
+    std::ofstream(uri) << "written later";
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    REQUIRE(manager.processReloads() == 0);
+    REQUIRE(manager.generation(uri) == 0);
+    REQUIRE(manager.load<TextResource>(uri, 8)->text == "later");
+
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("ResourceWatcher", "[Directory reached through a symlink]")
+{
+    auto root = makeResourceDirectory(3);
+    auto link = root.parent_path() / "pgf_resource_manager_tests_link";
+    std::filesystem::remove(link);
+    std::filesystem::create_directory_symlink(root, link);
+
+    auto                            config = pg::foundation::ResourceWatcher::default_config();
+    pg::foundation::ResourceWatcher watcher(std::move(config.withDebounce(std::chrono::milliseconds(10))));
+    REQUIRE(watcher.watch("a", root / "0"));
+    REQUIRE(watcher.watch("b", link / "1"));
+    watcher.unwatch("a");
+    watcher.unwatch("b");
+
+    // both paths shared one inotify watch, it must be set up again
+    REQUIRE(watcher.watch("c", root / "2"));
+    std::ofstream(root / "2") << "changed";
+    std::vector<std::string> changed;
+    auto                     deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (changed.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        changed = watcher.takeChanged();
+    }
+    REQUIRE(changed == std::vector<std::string>{"c"});
+
+    std::filesystem::remove(link);
+    std::filesystem::remove_all(root);
+}
+
+TEST_CASE("ResourceWatcher", "[Deleted directory]")
+{
+    auto root = makeResourceDirectory(1);
+
+    auto                            config = pg::foundation::ResourceWatcher::default_config();
+    pg::foundation::ResourceWatcher watcher(std::move(config));
+    REQUIRE(watcher.watch("a", root / "0"));
+    std::filesystem::remove_all(root);
+
+    // inotify drops the watch with the directory
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (watcher.isWatched("a") && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    REQUIRE_FALSE(watcher.isWatched("a"));
+}
+#endif
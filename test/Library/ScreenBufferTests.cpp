@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#include <pgf/console/ScreenBuffer.hpp>
+#include <pgf/console/miniAnsi.hpp>
+
+using namespace pg::foundation::console;
+
+TEST_CASE("ScreenBuffer", "[Diff]")
+{
+    ScreenBuffer screen(10, 3);
+    REQUIRE(screen.print(1, 0, "hello") == 6);
+
+    // the first frame clears the screen and draws the non blank cells
+    REQUIRE(screen.render() == "\033[0m\033[2J\033[1;2Hhello");
+    // nothing changed, nothing to write
+    REQUIRE(screen.render().empty());
+
+    // a single changed cell is a move and a character
+    screen.put(3, 2, U'x');
+    REQUIRE(screen.render() == "\033[3;4Hx");
+
+    // short unchanged gaps are rewritten instead of moved over
+    screen.put(1, 0, U'H');
+    screen.put(4, 0, U'L');
+    REQUIRE(screen.render() == "\033[1;2HHelL");
+
+    // style changes are emitted once per run of equal styles
+    const Style red{.foreground = 1, .attributes = Style::Bold};
+    screen.print(1, 1, "ab", red);
+    screen.put(3, 1, U'c');
+    REQUIRE(screen.render() == "\033[2;2H\033[0;1;38;5;1mab\033[0mc");
+
+    // removing text draws blanks
+    screen.clear();
+    REQUIRE(screen.render() == "\033[1;2H     \033[2;2H   \033[3;4H ");
+}
+
+TEST_CASE("ScreenBuffer", "[Clipping and text]")
+{
+    ScreenBuffer screen(4, 2);
+    REQUIRE(screen.print(2, 1, "\xc3\xa4\xe2\x82\xac!") == 4); // ä€ and a clipped !
+    REQUIRE(screen.at(2, 1).codepoint == U'ä');
+    REQUIRE(screen.at(3, 1).codepoint == U'€');
+    screen.put(-1, 0, U'x');
+    screen.put(4, 0, U'x');
+    screen.put(0, 5, U'x');
+    REQUIRE(screen.render() == "\033[0m\033[2J\033[2;3H\xc3\xa4\xe2\x82\xac");
+
+    // invalid UTF-8 becomes the replacement character
+    screen.print(0, 0, "\xff");
+    REQUIRE(screen.at(0, 0).codepoint == U'\uFFFD');
+    // as are overlong forms, surrogates, codepoints past U+10FFFF and the leads that would encode them
+    for (const char* invalid : {"\xc0\xaf", "\xe0\x80\xaf", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xf5\x80\x80\x80"})
+    {
+        screen.put(0, 0, U'x');
+        screen.print(0, 0, invalid);
+        REQUIRE(screen.at(0, 0).codepoint == U'\uFFFD');
+    }
+    screen.print(0, 0, "\xf4\x8f\xbf\xbf");
+    REQUIRE(screen.at(0, 0).codepoint == U'\U0010FFFF');
+
+    screen.invalidate();
+    REQUIRE(screen.render().starts_with("\033[0m\033[2J"));
+    screen.resize(2, 1);
+    REQUIRE(screen.width() == 2);
+    REQUIRE(screen.render() == "\033[0m\033[2J");
+}
+
+#ifndef _WIN32
+TEST_CASE("ScreenBuffer", "[Failed present]")
+{
+    ScreenBuffer screen(4, 1);
+    screen.render();
+    screen.print(0, 0, "ab");
+
+    // a frame the terminal did not take is drawn again in full
+    const auto saved = ::dup(STDOUT_FILENO);
+    ::close(STDOUT_FILENO);
+    screen.present();
+    ::dup2(saved, STDOUT_FILENO);
+    ::close(saved);
+    REQUIRE(screen.render() == "\033[0m\033[2J\033[1;1Hab");
+}
+#endif
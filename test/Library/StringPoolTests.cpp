@@ -0,0 +1,81 @@
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <pgf/strings/StringPool.hpp>
+
+using namespace pg::foundation::strings;
+
+TEST_CASE("StringPool", "[StringPool]")
+{
+    StringPool pool;
+    auto       grass = pool.intern("textures/grass.png");
+    auto       stone = pool.intern(std::string("textures/stone.png"));
+
+    REQUIRE(grass.view() == "textures/grass.png");
+    REQUIRE(std::string_view{grass.c_str()} == "textures/grass.png");
+    REQUIRE(grass.id() == 0);
+    REQUIRE(stone.id() == 1);
+    REQUIRE(pool.intern(std::string("textures/") + "grass.png") == grass);
+    REQUIRE(grass != stone);
+    REQUIRE(grass.hash() == std::hash<std::string_view>{}("textures/grass.png"));
+    REQUIRE(pool.size() == 2);
+
+    REQUIRE(pool.symbol(1) == stone);
+    REQUIRE(pool.view(0) == "textures/grass.png");
+    REQUIRE_THROWS_AS(pool.symbol(2), std::out_of_range);
+
+    REQUIRE(pool.find("textures/stone.png") == stone);
+    REQUIRE_FALSE(pool.find("textures/water.png"));
+    REQUIRE(pool.size() == 2);
+
+    REQUIRE_FALSE(Symbol{});
+    REQUIRE(Symbol{}.view().empty());
+    REQUIRE(pool.intern("").view().empty());
+
+    std::unordered_map<Symbol, int> ids{{grass, 1}, {stone, 2}};
+    REQUIRE(ids.at(pool.intern("textures/stone.png")) == 2);
+}
+
+TEST_CASE("StringPool arena", "[StringPool]")
+{
+    StringPool pool;
+    // enough to fill several chunks, plus strings larger than a chunk
+    std::vector<Symbol> symbols;
+    for (int i = 0; i < 20000; ++i)
+    {
+        symbols.push_back(pool.intern(std::to_string(i)));
+    }
+    const std::string large(100000, 'x');
+    auto              large_symbol = pool.intern(large);
+    for (int i = 0; i < 20000; ++i)
+    {
+        REQUIRE(symbols[static_cast<size_t>(i)].view() == std::to_string(i));
+    }
+    REQUIRE(large_symbol.view() == large);
+    REQUIRE(pool.memoryUsage() > large.size());
+}
+
+TEST_CASE("StringPool concurrent interning", "[StringPool]")
+{
+    StringPool pool;
+    std::vector<std::vector<Symbol>> results(4);
+    {
+        std::vector<std::jthread> threads;
+        for (auto& result : results)
+        {
+            threads.emplace_back([&pool, &result] {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    result.push_back(pool.intern("uri/" + std::to_string(i)));
+                }
+            });
+        }
+    }
+    REQUIRE(pool.size() == 1000);
+    for (const auto& result : results)
+    {
+        REQUIRE(result == results.front());
+    }
+}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <unordered_map>
+#include <catch2/catch_test_macros.hpp>
+#include <pgf/strings/Regex.hpp>
+#include <pgf/strings/StringTools.hpp>
+
+using namespace pg::foundation::strings;
+
+TEST_CASE("WildcardPattern", "[WildcardPattern]")
+{
+    SECTION("literal")
+    {
+        WildcardPattern pattern("grass.png");
+        REQUIRE(pattern.matches("grass.png"));
+        REQUIRE_FALSE(pattern.matches("grass.pn"));
+        REQUIRE_FALSE(pattern.matches("grassXpng"));
+        REQUIRE_FALSE(pattern.matches("Grass.png"));
+    }
+    SECTION("stars")
+    {
+        WildcardPattern pattern("textures/*.png");
+        REQUIRE(pattern.matches("textures/grass.png"));
+        REQUIRE(pattern.matches("textures/.png"));
+        REQUIRE(pattern.matches("textures/a/b.png"));
+        REQUIRE_FALSE(pattern.matches("textures/grass.jpg"));
+        REQUIRE_FALSE(pattern.matches("sprites/grass.png"));
+
+        REQUIRE(WildcardPattern("*").matches(""));
+        REQUIRE(WildcardPattern("**").matches("anything"));
+        REQUIRE(WildcardPattern("a**b").matches("ab"));
+        REQUIRE(WildcardPattern("*ab*ab").matches("abxabab"));
+        REQUIRE_FALSE(WildcardPattern("*ab*ab").matches("abxab_"));
+        REQUIRE_FALSE(WildcardPattern("a*a").matches("a"));
+    }
+    SECTION("question marks")
+    {
+        WildcardPattern pattern("tile_??.*");
+        REQUIRE(pattern.matches("tile_01.png"));
+        REQUIRE_FALSE(pattern.matches("tile_1.png"));
+        REQUIRE(WildcardPattern("*?x").matches("ax"));
+        REQUIRE_FALSE(WildcardPattern("*?x").matches("x"));
+    }
+    SECTION("regex characters are literals")
+    {
+        REQUIRE(WildcardPattern("a+b(1).txt").matches("a+b(1).txt"));
+        REQUIRE_FALSE(WildcardPattern("a+b").matches("aab"));
+    }
+    SECTION("case insensitive")
+    {
+        WildcardPattern pattern("*.PNG", false);
+        REQUIRE(pattern.matches("Grass.png"));
+        REQUIRE(pattern.matches("GRASS.PNG"));
+        REQUIRE_FALSE(WildcardPattern("*.PNG").matches("grass.png"));
+    }
+    SECTION("free function")
+    {
+        REQUIRE(matchesWildCard("grass.png", "*.png"));
+        REQUIRE(matchesWildCard("grass.PNG", "*.png", false));
+        REQUIRE_FALSE(matchesWildCard("grass.PNG", "*.png"));
+    }
+}
+
+TEST_CASE("RegexCache", "[RegexCache]")
+{
+    RegexCache cache(2);
+    auto       digits = cache.get("[0-9]+");
+    REQUIRE(digits->search("tile_12"));
+    REQUIRE_FALSE(digits->matches("tile_12"));
+    REQUIRE(cache.get("[0-9]+") == digits);
+    REQUIRE(cache.size() == 1);
+
+    cache.get("a+");
+    cache.get("[0-9]+"); // refresh, "a+" is now the least recently used
+    cache.get("b+");
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.get("[0-9]+") == digits);
+
+    REQUIRE_THROWS_AS(cache.get("("), std::regex_error);
+    REQUIRE(cache.size() == 2);
+
+    REQUIRE(matches(std::string_view{"grass_01.png"}, "_[0-9]{2}\\."));
+    REQUIRE_FALSE(matches("grass.png", "[0-9]"));
+}
+
+TEST_CASE("TokenView", "[tokenize]")
+{
+    static_assert(std::ranges::forward_range<TokenView>);
+    static_assert(std::ranges::view<TokenView>);
+
+    auto collect = [](TokenView view) {
+        std::vector<std::string_view> tokens;
+        std::ranges::copy(view, std::back_inserter(tokens));
+        return tokens;
+    };
+    SECTION("short input")
+    {
+        using Tokens = std::vector<std::string_view>;
+        REQUIRE(collect(TokenView("a bb  ccc ")) == Tokens{"a", "bb", "ccc"});
+        REQUIRE(collect(TokenView("  ")).empty());
+        REQUIRE(collect(TokenView("")).empty());
+        REQUIRE(collect(TokenView("key=value;other", "=;")) == Tokens{"key", "value", "other"});
+        REQUIRE(TokenView("a b").front() == "a");
+    }
+    SECTION("agrees with the scalar scan on long input")
+    {
+        // longer than a vector register in both directions, delimiter sets small and large
+        std::string text;
+        for (int i = 0; i < 200; ++i)
+        {
+            text += std::string(static_cast<size_t>(i % 37), 'x') + (i % 3 == 0 ? "  " : i % 3 == 1 ? "\t" : ",");
+        }
+        for (std::string_view delims : {" ", " \t,", " \t,;:|/\\.-_+=#@"})
+        {
+            std::vector<std::string_view> expected;
+            for (size_t first = 0; first < text.size();)
+            {
+                const auto last = std::min(text.find_first_of(delims, first), text.size());
+                if (last != first) { expected.emplace_back(std::string_view{text}.substr(first, last - first)); }
+                first = last + 1;
+            }
+            REQUIRE(collect(TokenView(text, delims)) == expected);
+            REQUIRE(tokenize(text, delims) == expected);
+        }
+    }
+}
+
+TEST_CASE("Case folding", "[toLower]")
+{
+    // long enough for the vectorized loops plus a scalar tail, bytes above 0x7f must be kept
+    const std::string mixed = "Textures/Grass_01.PNG @[`{ \xc3\x84pfel "
+                              "ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz";
+    std::string       lower = mixed;
+    std::string       upper = mixed;
+    std::ranges::transform(lower, lower.begin(), [](char c) { return c >= 'A' && c <= 'Z' ? char(c + 32) : c; });
+    std::ranges::transform(upper, upper.begin(), [](char c) { return c >= 'a' && c <= 'z' ? char(c - 32) : c; });
+
+    REQUIRE(toLower(mixed) == lower);
+    REQUIRE(toUpper(mixed) == upper);
+    REQUIRE(toLower("").empty());
+
+    std::string in_place = mixed;
+    toLowerInPlace(in_place);
+    REQUIRE(in_place == lower);
+    toUpperInPlace(in_place);
+    REQUIRE(in_place == upper);
+
+    REQUIRE(equalsIgnoreCase(mixed, lower));
+    REQUIRE(equalsIgnoreCase(upper, lower));
+    REQUIRE(hashIgnoreCase(mixed) == hashIgnoreCase(upper));
+    REQUIRE_FALSE(equalsIgnoreCase(mixed, mixed.substr(1)));
+    // '@' and '`', '[' and '{' only differ in the case bit, but are no letters
+    REQUIRE_FALSE(equalsIgnoreCase("@@@@@@@@@@@@@@@@[", "````````````````{"));
+    REQUIRE_FALSE(equalsIgnoreCase("[@@@@@@@@@@@@@@@@", "{````````````````"));
+
+    std::unordered_map<std::string, int, IgnoreCaseHash, IgnoreCaseEqual> uris{{"Textures/Grass.png", 1}};
+    REQUIRE(uris.find(std::string_view{"textures/GRASS.PNG"}) != uris.end());
+    REQUIRE(uris.find(std::string_view{"textures/grass.jpg"}) == uris.end());
+}
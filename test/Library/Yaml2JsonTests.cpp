@@ -0,0 +1,152 @@
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <catch2/catch_test_macros.hpp>
+#include <pgf/serialization/Yaml2Json.hpp>
+
+using pg::foundation::yaml2json;
+
+namespace {
+const std::string scene = R"(
+name: forest
+version: 3
+scale: 1.5
+visible: true
+hidden: Off
+empty:
+tilde: ~
+tags: [green, "quoted", 'single']
+base: &base
+  width: 10
+  height: 20
+levels:
+  - name: one
+    size: *base
+  - name: two
+    size: *base
+    extra: {a: 1, b: [1, 2, {c: null}]}
+text: |
+  multi
+  line "quoted"
+&key answer: 42
+nested: {*key : again}
+)";
+
+nlohmann::json streamed(const std::string& yaml)
+{
+    std::istringstream in(yaml);
+    return yaml2json(in);
+}
+
+nlohmann::json written(const std::string& yaml)
+{
+    std::istringstream in(yaml);
+    std::ostringstream out;
+    yaml2json(in, out);
+    return nlohmann::json::parse(out.str());
+}
+} // namespace
+
+TEST_CASE("Streaming yaml2json agrees with the node based conversion", "[Yaml2Json]")
+{
+    const auto expected = yaml2json(YAML::Load(scene));
+    REQUIRE(streamed(scene) == expected);
+    REQUIRE(written(scene) == expected);
+
+    REQUIRE(expected["version"] == 3);
+    REQUIRE(expected["scale"] == 1.5);
+    REQUIRE(expected["hidden"] == "Off");
+    REQUIRE(expected["visible"] == true);
+    REQUIRE(expected["empty"].is_null());
+    REQUIRE(expected["levels"][1]["size"]["height"] == 20);
+    REQUIRE(expected["levels"][1]["extra"]["b"][2]["c"].is_null());
+    REQUIRE(expected["nested"]["answer"] == "again");
+}
+
+TEST_CASE("Streaming yaml2json scalars and documents", "[Yaml2Json]")
+{
+    for (const std::string yaml :
+         {"42", "-7", "+3", "2.5e3", "yes", "TRUE", "tRue", "text", "", "[]", "{}", "[1, [2, [3]]]"})
+    {
+        CAPTURE(yaml);
+        const auto expected = yaml2json(YAML::Load(yaml));
+        REQUIRE(streamed(yaml) == expected);
+        REQUIRE(written(yaml) == expected);
+    }
+    REQUIRE(streamed("9223372036854775807") == INT64_MAX);
+    REQUIRE(streamed("tRue") == "tRue");
+    // only the first document is converted
+    REQUIRE(streamed("a: 1\n---\nb: 2\n") == nlohmann::json{{"a", 1}});
+}
+
+TEST_CASE("Streaming yaml2json errors", "[Yaml2Json]")
+{
+    REQUIRE_THROWS_AS(streamed("? [1, 2]\n: value\n"), std::invalid_argument);
+    REQUIRE_THROWS_AS(written("? {a: 1}\n: value\n"), std::invalid_argument);
+    REQUIRE_THROWS_AS(streamed("a: [1, 2"), YAML::ParserException);
+}
+
+TEST_CASE("Streaming yaml2json large output", "[Yaml2Json]")
+{
+    // more output than the writer buffers, with an anchor spanning a flush
+    std::string yaml = "anchored: &list\n";
+    for (int i = 0; i < 5000; ++i)
+    {
+        yaml += "  - {id: " + std::to_string(i) + ", name: \"item " + std::to_string(i) + "\"}\n";
+    }
+    yaml += "copy: *list\n";
+    const auto expected = yaml2json(YAML::Load(yaml));
+    REQUIRE(written(yaml) == expected);
+    REQUIRE(streamed(yaml) == expected);
+}
+
+TEST_CASE("YAML core schema scalars", "[Yaml2Json]")
+{
+    using pg::foundation::internal::parse_scalar;
+
+    REQUIRE(parse_scalar("~").is_null());
+    REQUIRE(parse_scalar("Null").is_null());
+    REQUIRE(parse_scalar("").is_null());
+    REQUIRE(parse_scalar("nil") == "nil");
+
+    REQUIRE(parse_scalar("true") == true);
+    REQUIRE(parse_scalar("FALSE") == false);
+    REQUIRE(parse_scalar("yes") == "yes");
+    REQUIRE(parse_scalar("tRue") == "tRue");
+
+    REQUIRE(parse_scalar("42") == 42);
+    REQUIRE(parse_scalar("+42") == 42);
+    REQUIRE(parse_scalar("-42") == -42);
+    REQUIRE(parse_scalar("007") == 7);
+    REQUIRE(parse_scalar("0o17") == 15);
+    REQUIRE(parse_scalar("0x1F") == 31);
+    REQUIRE(parse_scalar("-0x1F") == "-0x1F");
+    REQUIRE(parse_scalar("0o8") == "0o8");
+    REQUIRE(parse_scalar("9223372036854775807") == INT64_MAX);
+    REQUIRE(parse_scalar("-9223372036854775808") == INT64_MIN);
+    REQUIRE(parse_scalar("18446744073709551615").is_number_unsigned());
+    REQUIRE(parse_scalar("18446744073709551615") == UINT64_MAX);
+    REQUIRE(parse_scalar("18446744073709551616").is_number_float());
+    REQUIRE(parse_scalar("1_000") == "1_000");
+
+    REQUIRE(parse_scalar("1.5") == 1.5);
+    REQUIRE(parse_scalar("-.5") == -0.5);
+    REQUIRE(parse_scalar("2.") == 2.0);
+    REQUIRE(parse_scalar("1e3") == 1000.0);
+    REQUIRE(parse_scalar("+1.5E-1") == 0.15);
+    REQUIRE(parse_scalar("1e") == "1e");
+    REQUIRE(parse_scalar(".") == ".");
+    REQUIRE(parse_scalar("-") == "-");
+    REQUIRE(parse_scalar("inf") == "inf");
+    REQUIRE(parse_scalar("-inf") == "-inf");
+    REQUIRE(parse_scalar("nan") == "nan");
+    REQUIRE(std::isinf(parse_scalar("-.inf").get<double>()));
+    REQUIRE(std::isnan(parse_scalar(".NaN").get<double>()));
+
+    REQUIRE(parse_scalar("42", "!") == "42");
+    REQUIRE(parse_scalar("true", "tag:yaml.org,2002:str") == "true");
+
+    const auto quoted = yaml2json(YAML::Load("{a: '1', b: \"true\", c: 1, d: !!str 2}"));
+    REQUIRE(quoted == nlohmann::json{{"a", "1"}, {"b", "true"}, {"c", 1}, {"d", "2"}});
+    REQUIRE(streamed("{a: '1', b: \"true\", c: 1, d: !!str 2}") == quoted);
+}
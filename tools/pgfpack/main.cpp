@@ -0,0 +1,46 @@
+#include <charconv>
+#include <exception>
+#include <iostream>
+#include <string_view>
+#include <pgf/caching/PackArchive.hpp>
+
+namespace {
+int usage(const char* program)
+{
+    std::cerr << "usage: " << program << " <archive> <directory>... [--align <bytes>]" << std::endl;
+    return 1;
+}
+} // namespace
+
+// packs all files below one or more directories into a single archive to be served by the PackResourceLocator
+int main(int argc, char** argv)
+try
+{
+    if (argc < 3) { return usage(argv[0]); }
+
+    pg::foundation::PackWriter writer;
+    size_t                     alignment = 16;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string_view arg{argv[i]};
+        if (arg == "--align")
+        {
+            if (i + 1 == argc) { return usage(argv[0]); }
+            std::string_view value{argv[++i]};
+            const auto* end = value.data() + value.size();
+            auto [ptr, ec] = std::from_chars(value.data(), end, alignment);
+            if (ec != std::errc{} || ptr != end) { return usage(argv[0]); }
+            continue;
+        }
+        writer.addDirectory(arg);
+    }
+    writer.write(argv[1], alignment);
+
+    pg::foundation::PackArchive archive(argv[1]);
+    std::cout << "packed " << archive.size() << " resources into " << archive.path() << std::endl;
+}
+catch (const std::exception& e)
+{
+    std::cerr << e.what() << std::endl;
+    return 1;
+}